@@ -32,11 +32,15 @@ extern "C" {
 #  define _BASE_UNLIKELY(x) __builtin_expect(!!(x), 0)
 #  define _BASE_ALLOC_ATTR2(sz, al) __attribute__((malloc, alloc_size(sz), alloc_align(al)))
 #  define _BASE_ALLOC_ATTR(sz) __attribute__((malloc, alloc_size(sz)))
+#  define _BASE_PREFETCH(address) __builtin_prefetch(address)
+#  define _BASE_NO_SANITIZE __attribute__((no_sanitize_address))
 #else
 #  define _BASE_NORETURN __declspec(noreturn)
 #  define _BASE_UNLIKELY(x) x
 #  define _BASE_ALLOC_ATTR2(sz, al)
 #  define _BASE_ALLOC_ATTR(sz)
+#  define _BASE_PREFETCH(address) _mm_prefetch((const char *)(address), _MM_HINT_T0)
+#  define _BASE_NO_SANITIZE __declspec(no_sanitize_address)
 #endif
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
@@ -61,6 +65,7 @@ extern "C" {
 #  define _GNU_SOURCE
 #  include <dirent.h>
 #  include <fcntl.h>
+#  include <pthread.h>
 #  include <sys/stat.h>
 #  include <sys/types.h>
 #  include <unistd.h>
@@ -103,6 +108,7 @@ extern "C" {
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -112,6 +118,25 @@ extern "C" {
 #include <string.h>
 #include <time.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BASE_SSE2
+#  include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#  define BASE_SSSE3
+#  include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#  define BASE_AVX2
+#  include <immintrin.h>
+#endif
+
+#if defined(COMPILER_MSVC)
+#  include <intrin.h>
+#endif
+
 /* --- Platform Specific --- */
 #if defined(PLATFORM_WIN)
 /* Process functions */
@@ -189,6 +214,35 @@ typedef int64_t i64;
 typedef float f32;
 typedef double f64;
 
+// NOTE: Count trailing/leading zero bits, `x` must never be 0
+static inline u32 __BitCtz64(u64 x) {
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return index;
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+static inline u32 __BitClz64(u64 x) {
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanReverse64(&index, x);
+  return 63 - index;
+#else
+  return __builtin_clzll(x);
+#endif
+}
+
+static inline u32 __BitPopCount64(u64 x) {
+#if defined(COMPILER_MSVC)
+  return (u32)__popcnt64(x);
+#else
+  return __builtin_popcountll(x);
+#endif
+}
+
 typedef struct {
   size_t length; // Does not include null terminator
   char *data;
@@ -227,19 +281,26 @@ typedef struct {
 #define VEC_TYPE(typeName, valueType) \
   typedef struct {                    \
     valueType *data;                  \
-    i32 length;                       \
-    i32 capacity;                     \
+    size_t length;                    \
+    size_t capacity;                  \
   } typeName
 
+size_t __VecNextCapacity(size_t capacity, size_t elementSize, size_t initialCapacity);
+
+// NOTE: Doubles the capacity (aborts instead of wrapping around on overflow)
+#define __VecGrow(vector, initialCapacity)                                                         \
+  ({                                                                                               \
+    if (vector.length >= vector.capacity) {                                                        \
+      vector.capacity = __VecNextCapacity(vector.capacity, sizeof(*vector.data), initialCapacity); \
+      vector.data = Realloc(vector.data, vector.capacity * sizeof(*vector.data));                  \
+    }                                                                                              \
+  })
+
 // WARNING: Vector must always be initialized to zero `Vector vector = {0}`
 #define VecPush(vector, value)                                                                                   \
   ({                                                                                                             \
     assert(vector.length <= vector.capacity && "VecPush: Possible memory corruption or vector not initialized"); \
-    if (vector.length >= vector.capacity) {                                                                      \
-      if (vector.capacity == 0) vector.capacity = 128;                                                           \
-      else vector.capacity *= 2;                                                                                 \
-      vector.data = Realloc(vector.data, vector.capacity * sizeof(*vector.data));                                \
-    }                                                                                                            \
+    __VecGrow(vector, 128);                                                                                      \
     vector.data[vector.length++] = value;                                                                        \
     &vector.data[vector.length - 1];                                                                             \
   })
@@ -263,11 +324,7 @@ typedef struct {
 
 #define VecUnshift(vector, value)                                                      \
   ({                                                                                   \
-    if (vector.length >= vector.capacity) {                                            \
-      if (vector.capacity == 0) vector.capacity = 2;                                   \
-      else vector.capacity *= 2;                                                       \
-      vector.data = Realloc(vector.data, vector.capacity * sizeof(*vector.data));      \
-    }                                                                                  \
+    __VecGrow(vector, 2);                                                              \
                                                                                        \
     if (vector.length > 0) {                                                           \
       memmove(&vector.data[1], &vector.data[0], vector.length * sizeof(*vector.data)); \
@@ -281,11 +338,7 @@ typedef struct {
 #define VecInsert(vector, value, index)                                                                    \
   ({                                                                                                       \
     assert(index <= vector.length && "VecInsert: Index out of bounds for insertion");                      \
-    if (vector.length >= vector.capacity) {                                                                \
-      if (vector.capacity == 0) vector.capacity = 2;                                                       \
-      else vector.capacity *= 2;                                                                           \
-      vector.data = Realloc(vector.data, vector.capacity * sizeof(*vector.data));                          \
-    }                                                                                                      \
+    __VecGrow(vector, 2);                                                                                  \
     memmove(&vector.data[index + 1], &vector.data[index], (vector.length - index) * sizeof(*vector.data)); \
     vector.data[index] = value;                                                                            \
     vector.length++;                                                                                       \
@@ -307,6 +360,63 @@ typedef struct {
 
 #define VecForEach(vector, it) for (typeof(*vector.data) *it = vector.data; it < vector.data + vector.length; it++)
 
+/* --- Slot Map --- */
+// NOTE: Values stay packed in `data` for iteration, handles go through a slot table holding
+// the dense index and a generation, so they survive growth and stale handles are detected
+typedef u64 SlotMapHandle; // NOTE: Low 32 bits slot index, high 32 bits generation, 0 is never valid
+
+typedef struct {
+  u32 dense;      // NOTE: Index into `data` while occupied, next free slot + 1 otherwise
+  u32 generation; // NOTE: Odd while occupied, bumped on insert and on removal
+} __SlotMapSlot;
+
+typedef struct {
+  void *data;
+  u32 *slotOf; // NOTE: Slot of each dense value, patched when removal moves the last value
+  __SlotMapSlot *slots;
+  size_t length;
+  size_t capacity; // NOTE: Shared by the three arrays, there are never more slots than the peak length
+  size_t slotCount;
+  u32 freeHead; // NOTE: First free slot + 1, 0 when there is none
+} __SlotMap;
+
+#define SLOTMAP_TYPE(typeName, valueType) \
+  typedef struct {                        \
+    __SlotMap raw;                        \
+    valueType *_type;                     \
+  } typeName
+
+SlotMapHandle __SlotMapInsert(__SlotMap *map, size_t elementSize, void **value);
+void *__SlotMapGet(__SlotMap *map, size_t elementSize, SlotMapHandle handle);
+bool __SlotMapRemove(__SlotMap *map, size_t elementSize, SlotMapHandle handle);
+void __SlotMapFree(__SlotMap *map);
+
+// WARNING: Slot map must always be initialized to zero `Entities entities = {0}`
+#define SlotMapInsert(map, v)                                                                  \
+  ({                                                                                           \
+    typeof(map._type) __value;                                                                 \
+    SlotMapHandle __handle = __SlotMapInsert(&map.raw, sizeof(*map._type), (void **)&__value); \
+    *__value = (v);                                                                            \
+    __handle;                                                                                  \
+  })
+
+// NOTE: Returns NULL for removed handles, the pointer is only valid until the next insert or removal
+#define SlotMapGet(map, handle) ((typeof(map._type))__SlotMapGet(&map.raw, sizeof(*map._type), handle))
+#define SlotMapHas(map, handle) (SlotMapGet(map, handle) != NULL)
+#define SlotMapRemove(map, handle) __SlotMapRemove(&map.raw, sizeof(*map._type), handle)
+#define SlotMapLength(map) (map.raw.length)
+#define SlotMapFree(map) __SlotMapFree(&map.raw)
+
+// NOTE: Handle of the value `it` points to while iterating
+#define SlotMapHandleOf(map, it)                                         \
+  ({                                                                     \
+    u32 __slot = map.raw.slotOf[(it) - (typeof(map._type))map.raw.data]; \
+    ((SlotMapHandle)map.raw.slots[__slot].generation << 32) | __slot;    \
+  })
+
+// WARNING: Removing while iterating moves the last value into the current one, iterate backwards for that
+#define SlotMapForEach(map, it) for (typeof(map._type) it = map.raw.data; it < (typeof(map._type))map.raw.data + map.raw.length; it++)
+
 /* --- Time and Platforms --- */
 i64 TimeNow();
 void WaitTime(i64 ms);
@@ -350,6 +460,20 @@ void *Realloc(void *block, size_t size);
 void *Malloc(size_t size);
 void Free(void *address);
 
+/* --- Locks --- */
+#if defined(PLATFORM_WIN)
+typedef SRWLOCK RwLock;
+#else
+typedef pthread_rwlock_t RwLock;
+#endif
+
+void RwLockInit(RwLock *lock);
+void RwLockDestroy(RwLock *lock);
+void RwLockRead(RwLock *lock);
+void RwLockReadUnlock(RwLock *lock);
+void RwLockWrite(RwLock *lock);
+void RwLockWriteUnlock(RwLock *lock);
+
 /* --- String and Macros --- */
 #define STRING_LENGTH(s) ((sizeof(s) / sizeof((s)[0])) - sizeof((s)[0])) // NOTE: Inspired from clay.h
 #define ENSURE_STRING_LITERAL(x) ("" x "")
@@ -376,23 +500,553 @@ VEC_TYPE(StringVector, String);
     }                                                  \
   })
 
-void SetMaxStrSize(size_t size);
+void SetMaxStrSize(size_t size); // NOTE: Global cap for `StrNew`, unlimited by default and not thread safe, prefer `StrNewMax`
 String StrNew(Arena *arena, char *str);
+String StrNewMax(Arena *arena, char *str, size_t maxLength); // NOTE: Stops at `maxLength` bytes if no terminator came first
+// NOTE: Views over a C string without copying, a NULL `str` gives a null string
+String StrFromCStr(char *str);
+String StrFromCStrMax(char *str, size_t maxLength);
 String StrNewSize(Arena *arena, char *str, size_t len); // Without null terminator
 void StrCopy(String *destination, String *source);
-StringVector StrSplit(Arena *arena, String *string, String *delimiter);
+StringVector StrSplit(Arena *arena, String *string, String *delimiter); // NOTE: Null terminated copies of each piece
 StringVector StrSplitNewLine(Arena *arena, String *str);
+// NOTE: Pieces point into `string` and are not null terminated, only the vector itself is allocated
+StringVector StrSplitView(String *string, String *delimiter);
+StringVector StrSplitNewLineView(String *str);
+
+// NOTE: Lazy versions of `StrSplitView` and `StrSplitNewLineView`, one piece at a time and nothing allocated
+typedef struct {
+  String value; // NOTE: Current piece, points into the source
+  String rest;
+  String delimiter;
+  bool done;
+} StrSplitIter;
+
+StrSplitIter StrSplitIterNew(String *str, String *delimiter);
+bool StrSplitNext(StrSplitIter *it);
+
+#define StrSplitForEach(str, delimiter, it) for (StrSplitIter it = StrSplitIterNew(str, delimiter); StrSplitNext(&it);)
+
+// NOTE: Zero initialize `StrLineIter it = {0}` to stream chunks with `StrLineIterFeed`, a line cut by
+// the end of a chunk is carried over to the next one, `line` is valid until the next call
+typedef struct {
+  String line;
+  String rest;
+  char *carry; // NOTE: Heap buffer for the partial last line of previous chunks
+  size_t carryLength;
+  size_t carryCapacity;
+  bool final; // NOTE: No more chunks will come, the remaining bytes are the last line
+} StrLineIter;
+
+StrLineIter StrLineIterNew(String *str);
+void StrLineIterFeed(StrLineIter *it, String *chunk, bool last); // NOTE: Only once `StrLineNext` returned false
+bool StrLineNext(StrLineIter *it);
+void StrLineIterFree(StrLineIter *it);
+
+#define StrLineForEach(str, it) for (StrLineIter it = StrLineIterNew(str); StrLineNext(&it);)
+
+// NOTE: Line `i` spans `[offsets[i], offsets[i + 1] - 1)`, the last entry is a sentinel one past the end
+typedef struct {
+  String source;
+  size_t *offsets;
+  size_t count;
+} StrLineIndex;
+
+size_t StrCountLines(String *str); // NOTE: Same count as `StrSplitNewLineView` pieces
+StrLineIndex StrLineOffsets(Arena *arena, String *str);
+String StrLineAt(StrLineIndex *index, size_t line); // NOTE: O(1), without the line ending
 bool StrEqual(String *string1, String *string2);
+i32 StrCompare(String *string1, String *string2); // NOTE: Lexicographic byte order, shorter first on ties
+// NOTE: ASCII case only, other bytes compare as they are, `StrCompareNoCase` orders as if both were lowercase
+bool StrEqualNoCase(String *string1, String *string2);
+i32 StrCompareNoCase(String *string1, String *string2);
+// NOTE: Searches run in linear time for any input, an empty needle matches at the start (or end for `StrFindLast`)
+i64 StrFind(String *haystack, String *needle); // NOTE: Index of the first match, -1 when missing
+i64 StrFindLast(String *haystack, String *needle);
+bool StrContains(String *haystack, String *needle);
+bool StrStartsWith(String *str, String *prefix);
+bool StrEndsWith(String *str, String *suffix);
+size_t StrCount(String *haystack, String *needle); // NOTE: Non overlapping matches, `length + 1` for an empty needle
 String StrConcat(Arena *arena, String *string1, String *string2);
-void StrToUpper(String *string1);
+void StrToUpper(String *string1); // NOTE: In place and ASCII only, bytes above 127 are left alone
 void StrToLower(String *string1);
 bool StrIsNull(String *string);
-void StrTrim(String *string);
+void StrTrim(String *string); // NOTE: In place, moves the content to the start of the buffer
+// NOTE: Views into `string` without the leading and/or trailing whitespace, only the edges are scanned
+String StrTrimView(String *string);
+String StrTrimLeft(String *string);
+String StrTrimRight(String *string);
 String StrSlice(Arena *arena, String *str, size_t start, size_t end);
+
+// NOTE: The whole string must be the number, no whitespace. Integers take an optional sign, hex variants an
+// optional `0x` prefix, on overflow `result` saturates (floats become infinity) and `STR_PARSE_OVERFLOW` is returned
+enum StrParseError { STR_PARSE_INVALID = 1, STR_PARSE_OVERFLOW };
+errno_t StrToI64(String *str, i64 *result);
+errno_t StrToU64(String *str, u64 *result);
+errno_t StrToI64Hex(String *str, i64 *result);
+errno_t StrToU64Hex(String *str, u64 *result);
+errno_t StrToF64(String *str, f64 *result); // NOTE: Also `inf`, `infinity` and `nan`, correctly rounded, locale independent
+
+// NOTE: Floats print the shortest digits that parse back to the same value, in plain notation for
+// moderate exponents and `1.5e+300` otherwise. `buffer` needs `STR_NUMBER_MAX` bytes, no null terminator
+#define STR_NUMBER_MAX 32
+size_t StrWriteI64(char *buffer, i64 value);
+size_t StrWriteU64(char *buffer, u64 value);
+size_t StrWriteF64(char *buffer, f64 value);
+String StrFromI64(Arena *arena, i64 value);
+String StrFromU64(Arena *arena, u64 value);
+String StrFromF64(Arena *arena, f64 value);
 String ConvertExe(Arena *arena, String path);
 String ConvertPath(Arena *arena, String path);
 String ParsePath(Arena *arena, String path);
 
+/* --- String Builder --- */
+// NOTE: Growable string, arena builders grow in place while they are the arena's last allocation and
+// finish without copying, with a NULL arena the buffer lives on the heap until `StrBuilderFree`
+typedef struct {
+  char *data;
+  size_t length;
+  size_t capacity; // NOTE: Not counting the null terminator, which always has room
+  Arena *arena;
+} StringBuilder;
+
+StringBuilder StrBuilderNew(Arena *arena, size_t capacity);
+void StrBuilderReserve(StringBuilder *builder, size_t additional);
+void StrBuilderAppend(StringBuilder *builder, String *string);
+void StrBuilderAppendChar(StringBuilder *builder, char c);
+void StrBuilderAppendF(StringBuilder *builder, const char *format, ...) FORMAT_CHECK(2, 3);
+void StrBuilderAppendI64(StringBuilder *builder, i64 value);
+void StrBuilderAppendF64(StringBuilder *builder, f64 value);
+String StrBuilderFinish(StringBuilder *builder); // NOTE: Null terminated, heap builders still own the data
+void StrBuilderFree(StringBuilder *builder);
+
+// NOTE: Built in formatter without locale or `FILE` overhead, it supports `%d %i %u %o %x %X %c %s %p %f %%` with
+// `- 0 + #` and space flags, width, precision, `hh`/`h`/`l`/`ll`/`z`/`j`/`t` lengths and `%S` for a `String *` argument.
+// `%e %g %a` go through snprintf, any other directive is copied as written
+String Fmt(Arena *arena, const char *format, ...);
+void StrBuilderAppendFmt(StringBuilder *builder, const char *format, ...);
+
+/* --- String Matcher --- */
+// NOTE: Finds every occurrence of a fixed set of patterns in a single pass over the text. Large sets run an
+// Aho-Corasick DFA over byte classes, small sets on AVX2 use a Teddy style nibble filter that checks 32
+// positions at once and only verifies the candidates it finds
+typedef struct {
+  u32 pattern;   // NOTE: Index in the vector given to `StrMatcherNew`
+  size_t offset; // NOTE: Where the match starts in the text
+} StrMatch;
+
+VEC_TYPE(StrMatchVector, StrMatch);
+
+typedef struct __StrMatcherDfa __StrMatcherDfa;
+typedef struct __StrMatcherTeddy __StrMatcherTeddy;
+
+typedef struct {
+  String *patterns; // NOTE: Copies, the vector given to `StrMatcherNew` can be freed
+  u32 patternCount;
+  __StrMatcherDfa *dfa;
+  __StrMatcherTeddy *teddy; // NOTE: Used instead of the DFA when set
+} StrMatcher;
+
+StrMatcher StrMatcherNew(Arena *arena, StringVector *patterns); // NOTE: Patterns can't be empty, duplicates are fine
+StrMatchVector StrMatcherFindAll(StrMatcher *matcher, String *text); // NOTE: Overlapping ones too, ordered by offset then pattern
+bool StrMatcherContains(StrMatcher *matcher, String *text);
+
+/* --- UTF-8 --- */
+// NOTE: `String` stays bytes, these read them as UTF-8. Well formed means what the Unicode standard says,
+// no overlong forms, no surrogates and nothing past U+10FFFF
+typedef struct {
+  u32 *data;
+  size_t length;
+} StrUtf32;
+
+// NOTE: Invalid bytes come out one at a time as U+FFFD, so the iterator always moves forward
+typedef struct {
+  String source;
+  size_t offset; // NOTE: Where `codepoint` starts in the source
+  u32 codepoint;
+  u32 size; // NOTE: Bytes `codepoint` takes in the source
+} StrUtf8Iter;
+
+enum StrUtf8Error { STR_UTF8_INVALID = 1 };
+bool StrIsValidUtf8(String *str);
+size_t StrUtf8Length(String *str); // NOTE: Codepoints, it counts lead bytes so it's only exact for valid text
+StrUtf8Iter StrUtf8IterNew(String *str);
+bool StrUtf8Next(StrUtf8Iter *it);
+errno_t StrToUtf32(Arena *arena, String *str, StrUtf32 *result);
+errno_t StrFromUtf32(Arena *arena, StrUtf32 *str, String *result); // NOTE: Null terminated
+
+#define StrUtf8ForEach(str, it) for (StrUtf8Iter it = StrUtf8IterNew(str); StrUtf8Next(&it);)
+
+/* --- Hashing --- */
+// NOTE: wyhash based 64 bit hashing, fast on both short and long inputs but not cryptographic
+typedef struct {
+  u64 low;
+  u64 high;
+} Hash128;
+
+// NOTE: Streaming state, hashing data in chunks gives the same result as hashing it all at once
+typedef struct {
+  u64 seed;
+  u64 see1;
+  u64 see2;
+  u64 length;
+  size_t pending;
+  u8 buffer[64]; // NOTE: Last 16 bytes of the previous block followed by up to 48 pending bytes
+} HashState;
+
+u64 HashBytes(const void *data, size_t length, u64 seed);
+Hash128 HashBytes128(const void *data, size_t length, u64 seed);
+u64 StrHash(String *str);
+u64 StrHashNoCase(String *str); // NOTE: Same as `StrHash` of the lowercased string, without making the copy
+void HashInit(HashState *state, u64 seed);
+void HashUpdate(HashState *state, const void *data, size_t length);
+u64 HashFinal(HashState *state);
+Hash128 HashFinal128(HashState *state);
+
+/* --- Hash Map --- */
+// NOTE: Open addressing table with SIMD probing over groups of control bytes (swiss table)
+#define MAP_GROUP_WIDTH 16
+
+typedef struct {
+  u8 *ctrl;    // NOTE: One control byte per slot, either empty, deleted or the 7 low hash bits
+  void *slots; // NOTE: `capacity` entries of `{key, value}`
+  size_t length;
+  size_t capacity; // NOTE: Zero or a power of two multiple of `MAP_GROUP_WIDTH`
+  size_t tombstones;
+  Arena *arena; // NOTE: When set tables are allocated from it and never freed, otherwise heap
+} __Map;
+
+typedef struct {
+  size_t entrySize;
+  size_t keySize;
+  size_t valueOffset;
+  bool stringKey; // NOTE: `String` keys hash and compare their contents like `StrEqual`
+} __MapLayout;
+
+// NOTE: Non `String` keys are hashed and compared byte by byte, zero initialize padded structs
+#define MAP_TYPE(typeName, keyType, valueType) \
+  typedef struct {                             \
+    keyType key;                               \
+    valueType value;                           \
+  } typeName##Entry;                           \
+  typedef struct {                             \
+    __Map raw;                                 \
+    typeName##Entry *_type;                    \
+  } typeName
+
+#define __MAP_IS_STRING(key) _Generic((key), String: true, default: false)
+#define __MAP_LAYOUT(map) ((__MapLayout){sizeof(*map._type), sizeof(map._type->key), offsetof(typeof(*map._type), value), __MAP_IS_STRING(map._type->key)})
+
+void *__MapFind(__Map *map, __MapLayout layout, const void *key);
+void *__MapInsert(__Map *map, __MapLayout layout, const void *key, bool *inserted);
+bool __MapRemove(__Map *map, __MapLayout layout, const void *key);
+void __MapReserve(__Map *map, __MapLayout layout, size_t count);
+void *__MapNext(__Map *map, __MapLayout layout, void *entry);
+void __MapFree(__Map *map);
+
+// WARNING: Map must always be initialized to zero `Map map = {0}` (heap backed) or with `MapInit`
+#define MapInit(map, arenaPtr)    \
+  ({                              \
+    memset(&map, 0, sizeof(map)); \
+    map.raw.arena = arenaPtr;     \
+  })
+
+// NOTE: Inserts or overwrites, `String` keys are stored as is so their data must outlive the map
+#define MapPut(map, k, v)                                                               \
+  ({                                                                                    \
+    typeof(map._type->key) __key = (k);                                                 \
+    typeof(map._type) __entry = __MapInsert(&map.raw, __MAP_LAYOUT(map), &__key, NULL); \
+    __entry->value = (v);                                                               \
+    &__entry->value;                                                                    \
+  })
+
+#define MapGet(map, k)                                                          \
+  ({                                                                            \
+    typeof(map._type->key) __key = (k);                                         \
+    typeof(map._type) __entry = __MapFind(&map.raw, __MAP_LAYOUT(map), &__key); \
+    __entry ? &__entry->value : NULL;                                           \
+  })
+
+#define MapHas(map, k) (MapGet(map, k) != NULL)
+
+#define MapRemove(map, k)                             \
+  ({                                                  \
+    typeof(map._type->key) __key = (k);               \
+    __MapRemove(&map.raw, __MAP_LAYOUT(map), &__key); \
+  })
+
+#define MapReserve(map, count) __MapReserve(&map.raw, __MAP_LAYOUT(map), count)
+#define MapLength(map) (map.raw.length)
+#define MapFree(map) __MapFree(&map.raw)
+
+// NOTE: Removing the current entry while iterating is allowed, inserting is not
+#define MapForEach(map, it) \
+  for (typeof(map._type) it = __MapNext(&map.raw, __MAP_LAYOUT(map), NULL); it != NULL; it = __MapNext(&map.raw, __MAP_LAYOUT(map), it))
+
+/* --- Concurrent Hash Map --- */
+// NOTE: Lock striping, each shard is a regular `__Map` behind its own `RwLock` so readers only contend per shard
+#define CONCURRENT_MAP_SHARDS 64
+
+typedef struct {
+  _Alignas(64) RwLock lock; // NOTE: Own cache line so shards don't false share
+  __Map map;
+} __ConcurrentMapShard;
+
+#define CONCURRENT_MAP_TYPE(typeName, keyType, valueType) \
+  typedef struct {                                        \
+    keyType key;                                          \
+    valueType value;                                      \
+  } typeName##Entry;                                      \
+  typedef struct {                                        \
+    __ConcurrentMapShard shards[CONCURRENT_MAP_SHARDS];   \
+    typeName##Entry *_type;                               \
+  } typeName
+
+// NOTE: Runs under the shard write lock, `value` is zeroed when `exists` is false, must not touch the map
+typedef void (*ConcurrentMapComputeFn)(void *value, bool exists, void *userData);
+
+void __ConcurrentMapInit(__ConcurrentMapShard *shards);
+void __ConcurrentMapFree(__ConcurrentMapShard *shards);
+bool __ConcurrentMapGet(__ConcurrentMapShard *shards, __MapLayout layout, void *entry);
+bool __ConcurrentMapInsert(__ConcurrentMapShard *shards, __MapLayout layout, const void *entry, bool overwrite);
+void __ConcurrentMapCompute(__ConcurrentMapShard *shards, __MapLayout layout, const void *key, ConcurrentMapComputeFn fn, void *userData);
+bool __ConcurrentMapRemove(__ConcurrentMapShard *shards, __MapLayout layout, const void *key);
+size_t __ConcurrentMapLength(__ConcurrentMapShard *shards);
+
+// WARNING: Must call `ConcurrentMapInit` before use and `ConcurrentMapFree` after
+#define ConcurrentMapInit(map) __ConcurrentMapInit(map.shards)
+#define ConcurrentMapFree(map) __ConcurrentMapFree(map.shards)
+
+// NOTE: Copies the value out to `outValue` since entries can move as soon as the lock is released
+#define ConcurrentMapGet(map, k, outValue)                                      \
+  ({                                                                            \
+    typeof(*map._type) __entry;                                                 \
+    memset(&__entry, 0, sizeof(__entry));                                       \
+    __entry.key = (k);                                                          \
+    bool __found = __ConcurrentMapGet(map.shards, __MAP_LAYOUT(map), &__entry); \
+    if (__found) *(outValue) = __entry.value;                                   \
+    __found;                                                                    \
+  })
+
+#define __ConcurrentMapPut(map, k, v, overwrite)                               \
+  ({                                                                           \
+    typeof(*map._type) __entry;                                                \
+    memset(&__entry, 0, sizeof(__entry));                                      \
+    __entry.key = (k);                                                         \
+    __entry.value = (v);                                                       \
+    __ConcurrentMapInsert(map.shards, __MAP_LAYOUT(map), &__entry, overwrite); \
+  })
+
+// NOTE: Both return true when the key was inserted
+#define ConcurrentMapPut(map, k, v) __ConcurrentMapPut(map, k, v, true)
+#define ConcurrentMapPutIfAbsent(map, k, v) __ConcurrentMapPut(map, k, v, false)
+
+#define ConcurrentMapCompute(map, k, fn, userData)                               \
+  ({                                                                             \
+    typeof(map._type->key) __key = (k);                                          \
+    __ConcurrentMapCompute(map.shards, __MAP_LAYOUT(map), &__key, fn, userData); \
+  })
+
+#define ConcurrentMapRemove(map, k)                               \
+  ({                                                              \
+    typeof(map._type->key) __key = (k);                           \
+    __ConcurrentMapRemove(map.shards, __MAP_LAYOUT(map), &__key); \
+  })
+
+#define ConcurrentMapLength(map) __ConcurrentMapLength(map.shards)
+
+/* --- Integer Map and Set --- */
+// NOTE: Robin hood hashing with keys stored inline, `INT_MAP_EMPTY_KEY` is reserved and can't be inserted
+#define INT_MAP_EMPTY_KEY U64_MAX
+
+// WARNING: Must always be initialized to zero `IntMap map = {0}`
+typedef struct {
+  u64 *keys;
+  u64 *values;
+  size_t length;
+  size_t capacity;
+} IntMap;
+
+typedef struct {
+  u64 *keys;
+  size_t length;
+  size_t capacity;
+} IntSet;
+
+u64 *IntMapGet(IntMap *map, u64 key);
+u64 *IntMapPut(IntMap *map, u64 key, u64 value); // NOTE: Inserts or overwrites
+bool IntMapRemove(IntMap *map, u64 key);
+void IntMapReserve(IntMap *map, size_t count);
+void IntMapGetMany(IntMap *map, const u64 *keys, size_t count, u64 **results); // NOTE: Prefetches ahead, `NULL` results for missing keys
+void IntMapFree(IntMap *map);
+
+bool IntSetAdd(IntSet *set, u64 key); // NOTE: Returns false if it was already there
+bool IntSetHas(IntSet *set, u64 key);
+bool IntSetRemove(IntSet *set, u64 key);
+void IntSetReserve(IntSet *set, size_t count);
+void IntSetHasMany(IntSet *set, const u64 *keys, size_t count, bool *results);
+void IntSetFree(IntSet *set);
+
+/* --- String Interning --- */
+// NOTE: Stores each unique string once, ids compare with `==` and stay valid until `InternTableFree`
+#define __INTERN_FIRST_PAGE_BITS 10
+#define __INTERN_PAGES (33 - __INTERN_FIRST_PAGE_BITS)
+
+MAP_TYPE(__InternMap, String, u32);
+
+typedef struct {
+  Arena *arena;
+  __InternMap ids;
+  String *pages[__INTERN_PAGES]; // NOTE: Page `n` holds `1024 << n` strings and never moves
+  u32 count;
+  RwLock lock;
+} InternTable;
+
+InternTable *InternTableCreate();
+void InternTableFree(InternTable *table);
+u32 StrIntern(InternTable *table, String *str); // NOTE: Thread safe, inserts happen under a write lock
+bool StrInternFind(InternTable *table, String *str, u32 *id);
+String StrInternGet(InternTable *table, u32 id); // NOTE: Lock free, `id` must come from `StrIntern`
+
+/* --- B-Tree --- */
+// NOTE: Ordered map, keys of a node are packed together and sized to a few cache lines
+#define __BTREE_MAX_DEPTH 32
+
+typedef i32 (*__BTreeCompareFn)(const void *key1, const void *key2);
+
+typedef struct __BTreeNode {
+  u16 count;
+  bool leaf;
+  _Alignas(16) char data[]; // NOTE: Keys, then values, then children for inner nodes
+} __BTreeNode;
+
+typedef struct {
+  __BTreeNode *root;
+  size_t length;
+  Arena *arena; // NOTE: When set nodes are allocated from it and recycled on removal, otherwise heap
+  __BTreeNode *freeLeaves;
+  __BTreeNode *freeInner;
+} __BTree;
+
+typedef struct {
+  size_t keySize;
+  size_t valueSize;
+  __BTreeCompareFn compare;
+} __BTreeLayout;
+
+// NOTE: `key` and `value` point at the current entry, both NULL once past the end
+typedef struct {
+  void *key;
+  void *value;
+  __BTreeNode *nodes[__BTREE_MAX_DEPTH];
+  u16 indices[__BTREE_MAX_DEPTH];
+  i32 depth;
+} BTreeIter;
+
+i32 __BTreeCompareString(const void *key1, const void *key2);
+i32 __BTreeCompareI64(const void *key1, const void *key2);
+i32 __BTreeCompareU64(const void *key1, const void *key2);
+i32 __BTreeCompareI32(const void *key1, const void *key2);
+i32 __BTreeCompareU32(const void *key1, const void *key2);
+i32 __BTreeCompareF64(const void *key1, const void *key2);
+
+// NOTE: Supported key types, `String` keys are stored as is so their data must outlive the tree
+#define __BTREE_COMPARE(key)        \
+  _Generic((key),                   \
+      String: __BTreeCompareString, \
+      i64: __BTreeCompareI64,       \
+      u64: __BTreeCompareU64,       \
+      i32: __BTreeCompareI32,       \
+      u32: __BTreeCompareU32,       \
+      f64: __BTreeCompareF64)
+
+#define BTREE_TYPE(typeName, keyType, valueType) \
+  typedef struct {                               \
+    __BTree raw;                                 \
+    keyType *_key;                               \
+    valueType *_value;                           \
+  } typeName
+
+#define __BTREE_LAYOUT(tree) ((__BTreeLayout){sizeof(*tree._key), sizeof(*tree._value), __BTREE_COMPARE(*tree._key)})
+
+void *__BTreePut(__BTree *tree, __BTreeLayout layout, const void *key, const void *value);
+void *__BTreeGet(__BTree *tree, __BTreeLayout layout, const void *key);
+bool __BTreeRemove(__BTree *tree, __BTreeLayout layout, const void *key);
+BTreeIter __BTreeLowerBound(__BTree *tree, __BTreeLayout layout, const void *key);
+void __BTreeNext(__BTreeLayout layout, BTreeIter *it);
+void __BTreeBuild(__BTree *tree, __BTreeLayout layout, const void *keys, const void *values, size_t count);
+void __BTreeFree(__BTree *tree, __BTreeLayout layout);
+
+// WARNING: Tree must always be initialized to zero `Tree tree = {0}` (heap backed) or with `BTreeInit`
+#define BTreeInit(tree, arenaPtr)   \
+  ({                                \
+    memset(&tree, 0, sizeof(tree)); \
+    tree.raw.arena = arenaPtr;      \
+  })
+
+// NOTE: Inserts or overwrites, returned pointers are valid until the next `BTreePut` or `BTreeRemove`
+#define BTreePut(tree, k, v)                                                            \
+  ({                                                                                    \
+    typeof(*tree._key) __key = (k);                                                     \
+    typeof(*tree._value) __value = (v);                                                 \
+    (typeof(tree._value))__BTreePut(&tree.raw, __BTREE_LAYOUT(tree), &__key, &__value); \
+  })
+
+#define BTreeGet(tree, k)                                                     \
+  ({                                                                          \
+    typeof(*tree._key) __key = (k);                                           \
+    (typeof(tree._value))__BTreeGet(&tree.raw, __BTREE_LAYOUT(tree), &__key); \
+  })
+
+#define BTreeRemove(tree, k)                                \
+  ({                                                        \
+    typeof(*tree._key) __key = (k);                         \
+    __BTreeRemove(&tree.raw, __BTREE_LAYOUT(tree), &__key); \
+  })
+
+// NOTE: Iterator at the first key greater or equal than `k`
+#define BTreeLowerBound(tree, k)                                \
+  ({                                                            \
+    typeof(*tree._key) __key = (k);                             \
+    __BTreeLowerBound(&tree.raw, __BTREE_LAYOUT(tree), &__key); \
+  })
+
+#define BTreeFirst(tree) __BTreeLowerBound(&tree.raw, __BTREE_LAYOUT(tree), NULL)
+#define BTreeNext(tree, it) __BTreeNext(__BTREE_LAYOUT(tree), &(it))
+#define BTreeKey(tree, it) (*(typeof(tree._key))(it).key)
+#define BTreeValue(tree, it) ((typeof(tree._value))(it).value)
+
+// NOTE: Bulk loads an empty tree from `count` keys sorted in increasing order without duplicates
+#define BTreeBuild(tree, keys, values, count) __BTreeBuild(&tree.raw, __BTREE_LAYOUT(tree), keys, values, count)
+#define BTreeLength(tree) (tree.raw.length)
+#define BTreeFree(tree) __BTreeFree(&tree.raw, __BTREE_LAYOUT(tree))
+
+// NOTE: The tree must not be modified while iterating
+#define BTreeForEach(tree, it) for (BTreeIter it = BTreeFirst(tree); it.key != NULL; BTreeNext(tree, it))
+#define BTreeForEachFrom(tree, k, it) for (BTreeIter it = BTreeLowerBound(tree, k); it.key != NULL; BTreeNext(tree, it))
+
+/* --- Radix Tree --- */
+// NOTE: Adaptive radix tree keyed by `String`, inner nodes grow from 4 to 16, 48 and 256 children
+// and compress single child paths, lookups are O(key length) no matter how many keys are stored
+typedef struct __RadixNode __RadixNode;
+
+typedef struct {
+  __RadixNode *root;
+  size_t length;
+  Arena *arena; // NOTE: Nodes and key copies live here, removal doesn't give memory back
+} RadixTree;
+
+// NOTE: Return false to stop iterating
+typedef bool (*RadixTreeVisitFn)(String key, void *value, void *userData);
+
+void RadixTreeInit(RadixTree *tree, Arena *arena);
+bool RadixTreeInsert(RadixTree *tree, String *key, void *value); // NOTE: Returns false if it overwrote an existing key
+void *RadixTreeGet(RadixTree *tree, String *key);
+bool RadixTreeRemove(RadixTree *tree, String *key);
+// NOTE: Value of the longest stored key that is a prefix of `key`, NULL if none
+void *RadixTreeLongestPrefix(RadixTree *tree, String *key, size_t *prefixLength);
+void RadixTreeForEachPrefix(RadixTree *tree, String *prefix, RadixTreeVisitFn fn, void *userData); // NOTE: In byte order
+
 /* --- Random --- */
 void RandomInit(); // NOTE: Must init before using
 u64 RandomGetSeed();
@@ -450,6 +1104,60 @@ errno_t FileRename(String *oldPath, String *newPath);
 
 bool Mkdir(String path); // NOTE: Mkdir if not exist
 
+/* --- File Cache --- */
+// NOTE: LRU cache of `FileRead` results, entries are revalidated against the file size and modify time
+typedef struct __FileCacheEntry {
+  String path; // NOTE: Own null terminated copy, also the map key
+  String contents;
+  Arena *arena; // NOTE: Holds `contents`, freed on eviction
+  i64 size;
+  i64 modifyTime; // NOTE: Full precision timestamp, not just seconds like `File`
+  i64 checkedAt;
+  struct __FileCacheEntry *prev;
+  struct __FileCacheEntry *next;
+} __FileCacheEntry;
+
+MAP_TYPE(__FileCacheMap, String, __FileCacheEntry *);
+
+typedef struct {
+  __FileCacheMap entries;
+  __FileCacheEntry *head; // NOTE: Most recently used
+  __FileCacheEntry *tail;
+  size_t bytes;
+  size_t maxBytes;
+  i64 ttl; // NOTE: Milliseconds an entry is trusted without checking the file again, 0 always checks
+} FileCache;
+
+FileCache *FileCacheCreate(size_t maxBytes, i64 ttl);
+// NOTE: Returns `FileReadError` codes, `result` points into the cache and is valid until the entry is evicted or reloaded
+errno_t FileCacheRead(FileCache *cache, String *path, String *result);
+void FileCacheInvalidate(FileCache *cache, String *path);
+void FileCacheFree(FileCache *cache);
+
+/* --- Bloom Filter --- */
+// NOTE: Blocked filters keep every bit of a key in one 64 byte block (a single cache miss per lookup)
+// at the cost of a slightly higher false positive rate for the same size
+typedef struct {
+  u64 *bits;
+  u64 bitCount; // NOTE: Always a multiple of 512
+  u32 hashCount;
+  bool blocked;
+} BloomFilter;
+
+void BloomFilterSize(u64 count, f64 falsePositiveRate, u64 *bitCount, u32 *hashCount);
+BloomFilter BloomFilterCreate(u64 count, f64 falsePositiveRate, bool blocked);
+void BloomFilterAdd(BloomFilter *filter, const void *data, size_t length);
+bool BloomFilterHas(BloomFilter *filter, const void *data, size_t length);
+void BloomFilterAddStr(BloomFilter *filter, String *str);
+bool BloomFilterHasStr(BloomFilter *filter, String *str);
+bool BloomFilterMerge(BloomFilter *destination, BloomFilter *source); // NOTE: Both must have been created with the same parameters
+void BloomFilterFree(BloomFilter *filter);
+
+errno_t BloomFilterSave(BloomFilter *filter, String *path); // NOTE: Returns `FileWriteError` codes
+
+enum BloomFilterLoadError { BLOOM_FILTER_READ_FAILED = 1, BLOOM_FILTER_INVALID_FORMAT };
+errno_t BloomFilterLoad(String *path, BloomFilter *filter);
+
 /* --- Logger --- */
 #define _RESET "\x1b[0m"
 #define _GRAY "\x1b[0;36m"
@@ -645,14 +1353,14 @@ void __ArenaNextChunk(Arena *arena, size_t bytes) {
 
 void *ArenaAllocAligned(Arena *arena, size_t size, size_t al) {
   // Align 'currPtr' forward to the specified alignment
-  intptr_t tail = arena->offset & (al - 1);
-  intptr_t aligned = tail ? arena->offset + al - arena->offset : arena->offset;
-  arena->offset = aligned + size;
+  size_t aligned = (arena->offset + al - 1) & ~(al - 1);
   void *result;
-  if (arena->offset > arena->current->cap) {
+  if (aligned + size > arena->current->cap) {
     __ArenaNextChunk(arena, size > arena->chunkSize ? size : arena->chunkSize);
+    arena->offset = size;
     result = arena->current->buffer;
   } else {
+    arena->offset = aligned + size;
     result = arena->current->buffer + aligned;
   }
   if (size) memset(result, 0, size);
@@ -713,20 +1421,195 @@ void Free(void *address) {
   free(address);
 }
 
+/* Locks Implementation */
+#  if defined(PLATFORM_WIN)
+void RwLockInit(RwLock *lock) {
+  InitializeSRWLock(lock);
+}
+
+void RwLockDestroy(RwLock *lock) {
+  (void)lock; // NOTE: SRW locks need no cleanup
+}
+
+void RwLockRead(RwLock *lock) {
+  AcquireSRWLockShared(lock);
+}
+
+void RwLockReadUnlock(RwLock *lock) {
+  ReleaseSRWLockShared(lock);
+}
+
+void RwLockWrite(RwLock *lock) {
+  AcquireSRWLockExclusive(lock);
+}
+
+void RwLockWriteUnlock(RwLock *lock) {
+  ReleaseSRWLockExclusive(lock);
+}
+#  else
+void RwLockInit(RwLock *lock) {
+  i32 result = pthread_rwlock_init(lock, NULL);
+  assert(result == 0 && "RwLockInit: pthread_rwlock_init should never fail");
+}
+
+void RwLockDestroy(RwLock *lock) {
+  pthread_rwlock_destroy(lock);
+}
+
+void RwLockRead(RwLock *lock) {
+  pthread_rwlock_rdlock(lock);
+}
+
+void RwLockReadUnlock(RwLock *lock) {
+  pthread_rwlock_unlock(lock);
+}
+
+void RwLockWrite(RwLock *lock) {
+  pthread_rwlock_wrlock(lock);
+}
+
+void RwLockWriteUnlock(RwLock *lock) {
+  pthread_rwlock_unlock(lock);
+}
+#  endif
+
+size_t __VecNextCapacity(size_t capacity, size_t elementSize, size_t initialCapacity) {
+  if (capacity == 0) {
+    return initialCapacity;
+  }
+
+  if (_BASE_UNLIKELY(capacity > SIZE_MAX / 2 / elementSize)) {
+    LogError("Vector: capacity overflow, cannot grow past %zu elements", capacity);
+    abort();
+  }
+
+  return capacity * 2;
+}
+
+/* Slot Map Implementation */
+SlotMapHandle __SlotMapInsert(__SlotMap *map, size_t elementSize, void **value) {
+  if (map->length == map->capacity) {
+    size_t capacity = __VecNextCapacity(map->capacity, elementSize, 16);
+    assert(capacity <= U32_MAX && "SlotMapInsert: slot map is full");
+    map->data = Realloc(map->data, capacity * elementSize);
+    map->slotOf = Realloc(map->slotOf, capacity * sizeof(u32));
+    map->slots = Realloc(map->slots, capacity * sizeof(__SlotMapSlot));
+    map->capacity = capacity;
+  }
+
+  u32 slot;
+  if (map->freeHead) {
+    slot = map->freeHead - 1;
+    map->freeHead = map->slots[slot].dense;
+  } else {
+    slot = map->slotCount++;
+    map->slots[slot].generation = 0;
+  }
+
+  __SlotMapSlot *entry = &map->slots[slot];
+  entry->generation++;
+  entry->dense = map->length;
+  map->slotOf[map->length] = slot;
+  *value = (char *)map->data + map->length * elementSize;
+  map->length++;
+  return ((SlotMapHandle)entry->generation << 32) | slot;
+}
+
+void *__SlotMapGet(__SlotMap *map, size_t elementSize, SlotMapHandle handle) {
+  u32 slot = (u32)handle;
+  u32 generation = (u32)(handle >> 32);
+  if (slot >= map->slotCount || map->slots[slot].generation != generation || !(generation & 1)) {
+    return NULL;
+  }
+  return (char *)map->data + map->slots[slot].dense * elementSize;
+}
+
+bool __SlotMapRemove(__SlotMap *map, size_t elementSize, SlotMapHandle handle) {
+  void *value = __SlotMapGet(map, elementSize, handle);
+  if (!value) {
+    return false;
+  }
+
+  u32 slot = (u32)handle;
+  u32 dense = map->slots[slot].dense;
+  u32 last = map->length - 1;
+  if (dense != last) {
+    memcpy(value, (char *)map->data + last * elementSize, elementSize);
+    u32 movedSlot = map->slotOf[last];
+    map->slotOf[dense] = movedSlot;
+    map->slots[movedSlot].dense = dense;
+  }
+  map->length--;
+
+  map->slots[slot].generation++;
+  map->slots[slot].dense = map->freeHead;
+  map->freeHead = slot + 1;
+  return true;
+}
+
+void __SlotMapFree(__SlotMap *map) {
+  Free(map->data);
+  Free(map->slotOf);
+  Free(map->slots);
+  memset(map, 0, sizeof(*map));
+}
+
 /* String Implementation */
-static size_t maxStringSize = 10000;
+static size_t maxStringSize = SIZE_MAX;
+
+#  if !defined(BASE_SSE2)
+// Eight bytes with the first one in the low bits on either byte order, the zero byte scan in `strLength` depends on it
+_BASE_NO_SANITIZE static inline u64 strLoadWord(const char *str) {
+  u64 word;
+  memcpy(&word, str, sizeof(word));
+#    if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#    endif
+  return word;
+}
+#  endif
 
-static size_t strLength(char *str, size_t maxSize) {
-  if (str == NULL) {
+// Length of `str` up to `maxSize` bytes, a block at a time. Loads are aligned so they never straddle a page,
+// reading past the terminator (or `maxSize`) stays in memory that is mapped even if it's not part of the string
+_BASE_NO_SANITIZE static size_t strLength(const char *str, size_t maxSize) {
+  if (str == NULL || maxSize == 0) {
     return 0;
   }
 
-  size_t len = 0;
-  while (len < maxSize && str[len] != '\0') {
-    len++;
+#  if defined(BASE_SSE2)
+  size_t misalign = (uintptr_t)str & 15;
+  __m128i zero = _mm_setzero_si128();
+  u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)(str - misalign)), zero)) >> misalign;
+  if (mask) {
+    return Min(__BitCtz64(mask), maxSize);
   }
-
-  return len;
+  for (size_t len = 16 - misalign; len < maxSize; len += 16) {
+    mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)(str + len)), zero));
+    if (mask) {
+      return Min(len + __BitCtz64(mask), maxSize);
+    }
+  }
+  return maxSize;
+#  else
+  // NOTE: Subtracting one from each byte borrows into the top bit of zero bytes, the lowest flagged one is exact.
+  // Words are loaded little endian (first byte lowest), so the masking and the trailing zero count below pick
+  // bytes in string order
+  size_t misalign = (uintptr_t)str & 7;
+  u64 word = strLoadWord(str - misalign);
+  word |= (1ULL << (misalign * 8)) - 1; // NOTE: Bytes before `str` can't be the terminator
+  u64 zeros = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+  if (zeros) {
+    return Min((__BitCtz64(zeros) >> 3) - misalign, maxSize);
+  }
+  for (size_t len = 8 - misalign; len < maxSize; len += 8) {
+    word = strLoadWord(str + len);
+    zeros = (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+    if (zeros) {
+      return Min(len + (__BitCtz64(zeros) >> 3), maxSize);
+    }
+  }
+  return maxSize;
+#  endif
 }
 
 static void addNullTerminator(char *str, size_t len) {
@@ -745,22 +1628,29 @@ String StrNewSize(Arena *arena, char *str, size_t len) {
   const size_t memorySize = sizeof(char) * len + 1; // NOTE: Includes null terminator
   char *allocatedString = ArenaAllocChars(arena, memorySize);
 
-  memcpy(allocatedString, str, memorySize);
+  memcpy(allocatedString, str, len); // NOTE: `str` may be a view, it doesn't need a terminator of its own
   addNullTerminator(allocatedString, len);
   return (String){len, allocatedString};
 }
 
-String StrNew(Arena *arena, char *str) {
-  const size_t len = strLength(str, maxStringSize);
+String StrNewMax(Arena *arena, char *str, size_t maxLength) {
+  const size_t len = strLength(str, maxLength);
   if (len == 0) {
     return (String){0, NULL};
   }
-  const size_t memorySize = sizeof(char) * len + 1; // NOTE: Includes null terminator
-  char *allocatedString = ArenaAllocChars(arena, memorySize);
+  return StrNewSize(arena, str, len);
+}
 
-  memcpy(allocatedString, str, memorySize);
-  addNullTerminator(allocatedString, len);
-  return (String){len, allocatedString};
+String StrNew(Arena *arena, char *str) {
+  return StrNewMax(arena, str, maxStringSize);
+}
+
+String StrFromCStr(char *str) {
+  return (String){.length = strLength(str, SIZE_MAX), .data = str};
+}
+
+String StrFromCStrMax(char *str, size_t maxLength) {
+  return (String){.length = strLength(str, maxLength), .data = str};
 }
 
 String s(char *msg) {
@@ -811,6 +1701,14 @@ void StrCopy(String *destination, String *source) {
   addNullTerminator(destination->data, destination->length);
 }
 
+i32 StrCompare(String *string1, String *string2) {
+  i32 result = memcmp(string1->data, string2->data, Min(string1->length, string2->length));
+  if (result != 0) {
+    return result;
+  }
+  return (string1->length > string2->length) - (string1->length < string2->length);
+}
+
 bool StrEqual(String *string1, String *string2) {
   if (string1->length != string2->length) {
     return false;
@@ -822,233 +1720,4665 @@ bool StrEqual(String *string1, String *string2) {
   return true;
 }
 
-// TODO: Change to (String *str, String delimiter);
-// ^ Malloc strings instead, update StringVecFree
-StringVector StrSplit(Arena *arena, String *str, String *delimiter) {
-  assert(!StrIsNull(str) && "StrSplit: str should never be NULL");
-  assert(!StrIsNull(delimiter) && "StrSplit: delimiter should never be NULL");
-
-  char *start = str->data;
-  const char *end = str->data + str->length;
-  char *curr = start;
-  StringVector result = {0};
-  if (delimiter->length == 0) {
-    for (size_t i = 0; i < str->length; i++) {
-      String currString = StrNewSize(arena, str->data + i, 1);
-      VecPush(result, currString);
+// Two way string matching (Crochemore-Perrin), O(n + m) time and O(1) space no matter the input. `reverse`
+// searches the mirrored strings, so the result is then counted from the end of the haystack
+#  define __TW_AT(data, length, index) (reverse ? (data)[(length) - 1 - (index)] : (data)[index])
+
+static i64 strTwoWayMaxSuffix(const u8 *needle, i64 length, i64 *period, bool reverse, bool tilde) {
+  i64 suffix = -1, j = 0, k = 1;
+  *period = 1;
+  while (j + k < length) {
+    u8 a = __TW_AT(needle, length, j + k);
+    u8 b = __TW_AT(needle, length, suffix + k);
+    if (tilde ? a > b : a < b) {
+      j += k;
+      k = 1;
+      *period = j - suffix;
+    } else if (a == b) {
+      if (k != *period) {
+        k++;
+      } else {
+        j += *period;
+        k = 1;
+      }
+    } else {
+      suffix = j++;
+      k = *period = 1;
     }
-    return result;
+  }
+  return suffix;
+}
+
+static i64 strTwoWay(const u8 *haystack, i64 length, const u8 *needle, i64 needleLength, bool reverse) {
+  i64 period, tildePeriod;
+  i64 suffix = strTwoWayMaxSuffix(needle, needleLength, &period, reverse, false);
+  i64 tildeSuffix = strTwoWayMaxSuffix(needle, needleLength, &tildePeriod, reverse, true);
+  if (tildeSuffix > suffix) {
+    suffix = tildeSuffix;
+    period = tildePeriod;
   }
 
-  while (curr < end) {
-    char *match = NULL;
-    for (char *search = curr; search <= end - delimiter->length; search++) {
-      if (memcmp(search, delimiter->data, delimiter->length) == 0) {
-        match = search;
-        break;
+  bool periodic = true;
+  for (i64 i = 0; i <= suffix && periodic; i++) {
+    periodic = __TW_AT(needle, needleLength, i) == __TW_AT(needle, needleLength, i + period);
+  }
+
+  if (periodic) {
+    // NOTE: `memory` remembers the prefix already known to match after a shift by the period
+    i64 memory = -1;
+    for (i64 j = 0; j <= length - needleLength;) {
+      i64 i = Max(suffix, memory) + 1;
+      while (i < needleLength && __TW_AT(needle, needleLength, i) == __TW_AT(haystack, length, i + j)) i++;
+      if (i >= needleLength) {
+        i = suffix;
+        while (i > memory && __TW_AT(needle, needleLength, i) == __TW_AT(haystack, length, i + j)) i--;
+        if (i <= memory) {
+          return j;
+        }
+        j += period;
+        memory = needleLength - period - 1;
+      } else {
+        j += i - suffix;
+        memory = -1;
       }
     }
+    return -1;
+  }
 
-    if (!match) {
-      String currString = StrNewSize(arena, curr, end - curr);
-      VecPush(result, currString);
-      break;
+  period = Max(suffix + 1, needleLength - suffix - 1) + 1;
+  for (i64 j = 0; j <= length - needleLength;) {
+    i64 i = suffix + 1;
+    while (i < needleLength && __TW_AT(needle, needleLength, i) == __TW_AT(haystack, length, i + j)) i++;
+    if (i >= needleLength) {
+      i = suffix;
+      while (i >= 0 && __TW_AT(needle, needleLength, i) == __TW_AT(haystack, length, i + j)) i--;
+      if (i < 0) {
+        return j;
+      }
+      j += period;
+    } else {
+      j += i - suffix;
     }
-
-    size_t len = match - curr;
-    String currString = StrNewSize(arena, curr, len);
-    VecPush(result, currString);
-
-    curr = match + delimiter->length;
   }
-
-  return result;
+  return -1;
 }
+#  undef __TW_AT
 
-StringVector StrSplitNewLine(Arena *arena, String *str) {
-  assert(!StrIsNull(str) && "SplitNewLine: str should never be NULL");
-  char *start = str->data;
-  const char *end = str->data + str->length;
-  char *curr = start;
-  StringVector result = {0};
+// Once candidates that fail verification cost more than the bytes scanned the input is adversarial,
+// the rest of the search switches to two way so the worst case stays linear
+#  define __STR_FIND_BUDGET(scanned) ((scanned) + 1024)
 
-  while (curr < end) {
-    char *pos = curr;
+static char *strFindTwoWay(char *data, size_t length, size_t from, const char *needle, size_t needleLength) {
+  i64 found = strTwoWay((const u8 *)data + from, length - from, (const u8 *)needle, needleLength, false);
+  return found < 0 ? NULL : data + from + found;
+}
+
+// First occurrence of `needle` or NULL, candidates are positions where both the first and the last
+// needle byte match, checked a whole vector at a time so most of the haystack never reaches memcmp
+static char *strFind(char *data, size_t length, const char *needle, size_t needleLength) {
+  if (needleLength == 0) {
+    return data;
+  }
+  if (needleLength > length) {
+    return NULL;
+  }
+  if (needleLength == 1) {
+    return (char *)memchr(data, needle[0], length);
+  }
+
+  size_t last = needleLength - 1;
+  size_t end = length - last; // NOTE: Candidate positions are [0, end)
+  size_t i = 0;
+  size_t wasted = 0;
+#  if defined(BASE_AVX2)
+  __m256i first32 = _mm256_set1_epi8(needle[0]);
+  __m256i last32 = _mm256_set1_epi8(needle[last]);
+  for (; i + 32 <= end; i += 32) {
+    __m256i firstMatch = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i)), first32);
+    __m256i lastMatch = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i + last)), last32);
+    u32 candidates = (u32)_mm256_movemask_epi8(_mm256_and_si256(firstMatch, lastMatch));
+    while (candidates) {
+      size_t position = i + __BitCtz64(candidates);
+      if (memcmp(data + position + 1, needle + 1, needleLength - 2) == 0) {
+        return data + position;
+      }
+      wasted += needleLength;
+      candidates &= candidates - 1;
+    }
+    if (_BASE_UNLIKELY(wasted > __STR_FIND_BUDGET(i))) {
+      return strFindTwoWay(data, length, i + 32, needle, needleLength);
+    }
+  }
+#  endif
+#  if defined(BASE_SSE2)
+  __m128i first16 = _mm_set1_epi8(needle[0]);
+  __m128i last16 = _mm_set1_epi8(needle[last]);
+  for (; i + 16 <= end; i += 16) {
+    __m128i firstMatch = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), first16);
+    __m128i lastMatch = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + last)), last16);
+    u32 candidates = (u32)_mm_movemask_epi8(_mm_and_si128(firstMatch, lastMatch));
+    while (candidates) {
+      size_t position = i + __BitCtz64(candidates);
+      if (memcmp(data + position + 1, needle + 1, needleLength - 2) == 0) {
+        return data + position;
+      }
+      wasted += needleLength;
+      candidates &= candidates - 1;
+    }
+    if (_BASE_UNLIKELY(wasted > __STR_FIND_BUDGET(i))) {
+      return strFindTwoWay(data, length, i + 16, needle, needleLength);
+    }
+  }
+#  endif
+  for (; i < end; i++) {
+    if (data[i] == needle[0] && data[i + last] == needle[last]) {
+      if (memcmp(data + i + 1, needle + 1, needleLength - 2) == 0) {
+        return data + i;
+      }
+      wasted += needleLength;
+      if (_BASE_UNLIKELY(wasted > __STR_FIND_BUDGET(i))) {
+        return strFindTwoWay(data, length, i + 1, needle, needleLength);
+      }
+    }
+  }
+  return NULL;
+}
+
+// Last occurrence of `needle` or NULL, same filter as `strFind` walking blocks from the end
+static char *strFindLast(char *data, size_t length, const char *needle, size_t needleLength) {
+  if (needleLength == 0) {
+    return data + length;
+  }
+  if (needleLength > length) {
+    return NULL;
+  }
+
+  size_t last = needleLength - 1;
+  size_t end = length - last; // NOTE: Candidate positions are [0, end), `end` shrinks as blocks are done
+  size_t wasted = 0;
+#  if defined(BASE_SSE2)
+  __m128i first16 = _mm_set1_epi8(needle[0]);
+  __m128i last16 = _mm_set1_epi8(needle[last]);
+  for (; end >= 16; end -= 16) {
+    size_t i = end - 16;
+    __m128i firstMatch = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i)), first16);
+    __m128i lastMatch = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + i + last)), last16);
+    u32 candidates = (u32)_mm_movemask_epi8(_mm_and_si128(firstMatch, lastMatch));
+    while (candidates) {
+      u32 bit = 63 - __BitClz64(candidates);
+      if (needleLength < 2 || memcmp(data + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+        return data + i + bit;
+      }
+      wasted += needleLength;
+      candidates &= ~(1u << bit);
+    }
+    if (_BASE_UNLIKELY(wasted > __STR_FIND_BUDGET(length - i))) {
+      end = i;
+      goto twoWay;
+    }
+  }
+#  endif
+  while (end > 0) {
+    size_t i = --end;
+    if (data[i] == needle[0] && data[i + last] == needle[last]) {
+      if (needleLength < 2 || memcmp(data + i + 1, needle + 1, needleLength - 2) == 0) {
+        return data + i;
+      }
+      wasted += needleLength;
+      if (_BASE_UNLIKELY(wasted > __STR_FIND_BUDGET(length - i))) {
+        goto twoWay;
+      }
+    }
+  }
+  return NULL;
+
+twoWay:;
+  // NOTE: Only candidates below `end` are left, which is a haystack of `end + last` bytes
+  i64 found = strTwoWay((const u8 *)data, end + last, (const u8 *)needle, needleLength, true);
+  return found < 0 ? NULL : data + (end + last) - found - needleLength;
+}
+
+i64 StrFind(String *haystack, String *needle) {
+  if (needle->length == 0) {
+    return 0; // NOTE: Also for `{0, NULL}` strings, where `strFind` would hand back a NULL match
+  }
+  char *match = strFind(haystack->data, haystack->length, needle->data, needle->length);
+  return match ? match - haystack->data : -1;
+}
+
+i64 StrFindLast(String *haystack, String *needle) {
+  if (needle->length == 0) {
+    return haystack->length;
+  }
+  char *match = strFindLast(haystack->data, haystack->length, needle->data, needle->length);
+  return match ? match - haystack->data : -1;
+}
+
+bool StrContains(String *haystack, String *needle) {
+  return needle->length == 0 || strFind(haystack->data, haystack->length, needle->data, needle->length) != NULL;
+}
+
+bool StrStartsWith(String *str, String *prefix) {
+  if (prefix->length == 0) {
+    return true;
+  }
+  return str->length >= prefix->length && memcmp(str->data, prefix->data, prefix->length) == 0;
+}
+
+bool StrEndsWith(String *str, String *suffix) {
+  if (suffix->length == 0) {
+    return true;
+  }
+  return str->length >= suffix->length && memcmp(str->data + str->length - suffix->length, suffix->data, suffix->length) == 0;
+}
+
+size_t StrCount(String *haystack, String *needle) {
+  if (needle->length == 0) {
+    return haystack->length + 1;
+  }
+
+  size_t count = 0;
+  char *cursor = haystack->data;
+  char *end = haystack->data + haystack->length;
+  char *match;
+  while ((match = strFind(cursor, end - cursor, needle->data, needle->length))) {
+    count++;
+    cursor = match + needle->length;
+  }
+  return count;
+}
+
+// Bit `i` is set when `block[i]` is a new line, blocks shorter than 64 bytes are padded with zeros
+static inline u64 strNewLineMask(const char *block, size_t length) {
+  char padded[64];
+  if (length < 64) {
+    memset(padded, 0, sizeof(padded));
+    memcpy(padded, block, length);
+    block = padded;
+  }
+#  if defined(BASE_AVX2)
+  __m256i newLine = _mm256_set1_epi8('\n');
+  u64 low = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)block), newLine));
+  u64 high = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(block + 32)), newLine));
+  return low | (high << 32);
+#  elif defined(BASE_SSE2)
+  __m128i newLine = _mm_set1_epi8('\n');
+  u64 mask = 0;
+  for (u32 i = 0; i < 4; i++) {
+    mask |= (u64)(u16)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(block + i * 16)), newLine)) << (i * 16);
+  }
+  return mask;
+#  else
+  u64 mask = 0;
+  for (u32 i = 0; i < 64; i++) {
+    mask |= (u64)(block[i] == '\n') << i;
+  }
+  return mask;
+#  endif
+}
+
+// Walks new line positions a 64 byte block at a time, `\r` before them is handled by the callers
+// looking at the previous byte, which works across block edges since it reads the source directly
+typedef struct {
+  const char *data;
+  size_t length;
+  size_t block;
+  u64 mask;
+} __NewLineScan;
+
+static __NewLineScan newLineScanNew(const char *data, size_t length) {
+  return (__NewLineScan){data, length, 0, length ? strNewLineMask(data, length) : 0};
+}
+
+static size_t newLineScanNext(__NewLineScan *scan) {
+  while (!scan->mask) {
+    scan->block += 64;
+    if (scan->block >= scan->length) {
+      return SIZE_MAX;
+    }
+    scan->mask = strNewLineMask(scan->data + scan->block, scan->length - scan->block);
+  }
+
+  size_t position = scan->block + __BitCtz64(scan->mask);
+  scan->mask &= scan->mask - 1;
+  return position;
+}
+
+StringVector StrSplitView(String *str, String *delimiter) {
+  assert(!StrIsNull(str) && "StrSplitView: str should never be NULL");
+  assert(!StrIsNull(delimiter) && "StrSplitView: delimiter should never be NULL");
+
+  char *start = str->data;
+  const char *end = str->data + str->length;
+  char *curr = start;
+  StringVector result = {0};
+  if (delimiter->length == 0) {
+    for (size_t i = 0; i < str->length; i++) {
+      VecPush(result, ((String){.length = 1, .data = str->data + i}));
+    }
+    return result;
+  }
+
+  while (curr < end) {
+    char *match = strFind(curr, end - curr, delimiter->data, delimiter->length);
+    if (!match) {
+      VecPush(result, ((String){.length = (size_t)(end - curr), .data = curr}));
+      break;
+    }
+
+    VecPush(result, ((String){.length = (size_t)(match - curr), .data = curr}));
+    curr = match + delimiter->length;
+  }
+
+  return result;
+}
+
+StringVector StrSplitNewLineView(String *str) {
+  assert(!StrIsNull(str) && "StrSplitNewLineView: str should never be NULL");
+  StringVector result = {0};
+  __NewLineScan scan = newLineScanNew(str->data, str->length);
+  size_t start = 0;
+  for (size_t position; (position = newLineScanNext(&scan)) != SIZE_MAX; start = position + 1) {
+    size_t len = position - start;
+    if (len && str->data[position - 1] == '\r') {
+      len--;
+    }
+    VecPush(result, ((String){.length = len, .data = str->data + start}));
+  }
+
+  if (start < str->length) {
+    VecPush(result, ((String){.length = str->length - start, .data = str->data + start}));
+  }
+  return result;
+}
+
+// Turns views into arena copies in place, so each piece gets its null terminator
+static void strSplitCopy(Arena *arena, StringVector *pieces) {
+  for (size_t i = 0; i < pieces->length; i++) {
+    pieces->data[i] = StrNewSize(arena, pieces->data[i].data, pieces->data[i].length);
+  }
+}
+
+StringVector StrSplit(Arena *arena, String *str, String *delimiter) {
+  assert(!StrIsNull(str) && "StrSplit: str should never be NULL");
+  assert(!StrIsNull(delimiter) && "StrSplit: delimiter should never be NULL");
+
+  StringVector result = StrSplitView(str, delimiter);
+  strSplitCopy(arena, &result);
+  return result;
+}
+
+StringVector StrSplitNewLine(Arena *arena, String *str) {
+  assert(!StrIsNull(str) && "SplitNewLine: str should never be NULL");
+
+  StringVector result = StrSplitNewLineView(str);
+  strSplitCopy(arena, &result);
+  return result;
+}
+
+StrSplitIter StrSplitIterNew(String *str, String *delimiter) {
+  assert(!StrIsNull(str) && "StrSplitIterNew: str should never be NULL");
+  assert(!StrIsNull(delimiter) && "StrSplitIterNew: delimiter should never be NULL");
+  return (StrSplitIter){.rest = *str, .delimiter = *delimiter};
+}
+
+bool StrSplitNext(StrSplitIter *it) {
+  if (it->done || it->rest.length == 0) {
+    it->done = true;
+    return false;
+  }
+
+  // NOTE: Same pieces as `StrSplitView`, an empty delimiter splits every byte
+  char *match = it->delimiter.length ? strFind(it->rest.data, it->rest.length, it->delimiter.data, it->delimiter.length) : it->rest.data + 1;
+  if (!match || match == it->rest.data + it->rest.length) {
+    it->value = it->rest;
+    it->rest.length = 0;
+    return true;
+  }
+
+  size_t skip = (match - it->rest.data) + it->delimiter.length;
+  it->value = (String){.length = (size_t)(match - it->rest.data), .data = it->rest.data};
+  it->rest.data += skip;
+  it->rest.length -= skip;
+  return true;
+}
+
+StrLineIter StrLineIterNew(String *str) {
+  assert(!StrIsNull(str) && "StrLineIterNew: str should never be NULL");
+  return (StrLineIter){.rest = *str, .final = true};
+}
+
+void StrLineIterFeed(StrLineIter *it, String *chunk, bool last) {
+  assert(it->rest.length == 0 && "StrLineIterFeed: previous chunk was not fully consumed");
+  it->rest = *chunk;
+  it->final = last;
+}
+
+static void strLineCarry(StrLineIter *it, char *data, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  if (it->carryLength + length > it->carryCapacity) {
+    it->carryCapacity = Max(it->carryCapacity * 2, it->carryLength + length);
+    it->carry = Realloc(it->carry, it->carryCapacity);
+  }
+  memcpy(it->carry + it->carryLength, data, length);
+  it->carryLength += length;
+}
+
+bool StrLineNext(StrLineIter *it) {
+  char *newLine = it->rest.length ? (char *)memchr(it->rest.data, '\n', it->rest.length) : NULL;
+  if (newLine) {
+    size_t length = newLine - it->rest.data;
+    if (it->carryLength) {
+      strLineCarry(it, it->rest.data, length);
+      it->line = (String){.length = it->carryLength, .data = it->carry};
+      it->carryLength = 0;
+    } else {
+      it->line = (String){.length = length, .data = it->rest.data};
+    }
+    it->rest.data += length + 1;
+    it->rest.length -= length + 1;
+
+    if (it->line.length && it->line.data[it->line.length - 1] == '\r') {
+      it->line.length--;
+    }
+    return true;
+  }
+
+  if (!it->final) {
+    strLineCarry(it, it->rest.data, it->rest.length);
+    it->rest.length = 0;
+    return false;
+  }
+
+  if (it->carryLength) {
+    strLineCarry(it, it->rest.data, it->rest.length);
+    it->line = (String){.length = it->carryLength, .data = it->carry};
+    it->carryLength = 0;
+  } else if (it->rest.length) {
+    it->line = it->rest;
+  } else {
+    return false;
+  }
+  it->rest.length = 0;
+  return true;
+}
+
+void StrLineIterFree(StrLineIter *it) {
+  Free(it->carry);
+  memset(it, 0, sizeof(*it));
+}
+
+size_t StrCountLines(String *str) {
+  assert(!StrIsNull(str) && "StrCountLines: str should never be NULL");
+  size_t count = 0;
+  for (size_t block = 0; block < str->length; block += 64) {
+    count += __BitPopCount64(strNewLineMask(str->data + block, str->length - block));
+  }
+
+  // NOTE: A last line without a trailing new line still counts
+  if (str->length && str->data[str->length - 1] != '\n') {
+    count++;
+  }
+  return count;
+}
+
+StrLineIndex StrLineOffsets(Arena *arena, String *str) {
+  assert(!StrIsNull(str) && "StrLineOffsets: str should never be NULL");
+  StrLineIndex index = {.source = *str, .count = StrCountLines(str)};
+  index.offsets = (size_t *)ArenaAlloc(arena, (index.count + 1) * sizeof(size_t));
+
+  __NewLineScan scan = newLineScanNew(str->data, str->length);
+  size_t line = 0;
+  index.offsets[0] = 0;
+  for (size_t position; (position = newLineScanNext(&scan)) != SIZE_MAX;) {
+    index.offsets[++line] = position + 1;
+  }
+  if (line < index.count) {
+    index.offsets[index.count] = str->length + 1; // NOTE: As if there was a trailing new line
+  }
+  return index;
+}
+
+String StrLineAt(StrLineIndex *index, size_t line) {
+  assert(line < index->count && "StrLineAt: line out of bounds");
+  size_t start = index->offsets[line];
+  size_t length = index->offsets[line + 1] - 1 - start;
+  char *data = index->source.data + start;
+  if (length && data[length - 1] == '\r' && index->offsets[line + 1] <= index->source.length) {
+    length--;
+  }
+  return (String){.length = length, .data = data};
+}
+
+// NOTE: ASCII only, flips bit 0x20 of bytes in `[first, first + 26)`, so 'A' lowers and 'a' uppers. The
+// range check is one signed compare once the range is shifted to start at -128
+static void strCaseFlip(char *data, size_t length, char first) {
+  size_t i = 0;
+#  if defined(BASE_AVX2)
+  __m256i shift32 = _mm256_set1_epi8((char)(0x80 - first));
+  __m256i limit32 = _mm256_set1_epi8(-128 + 26);
+  __m256i bit32 = _mm256_set1_epi8(0x20);
+  for (; i + 32 <= length; i += 32) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+    __m256i inRange = _mm256_cmpgt_epi8(limit32, _mm256_add_epi8(block, shift32));
+    _mm256_storeu_si256((__m256i *)(data + i), _mm256_xor_si256(block, _mm256_and_si256(inRange, bit32)));
+  }
+#  endif
+#  if defined(BASE_SSE2)
+  __m128i shift16 = _mm_set1_epi8((char)(0x80 - first));
+  __m128i limit16 = _mm_set1_epi8(-128 + 26);
+  __m128i bit16 = _mm_set1_epi8(0x20);
+  for (; i + 16 <= length; i += 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+    __m128i inRange = _mm_cmplt_epi8(_mm_add_epi8(block, shift16), limit16);
+    _mm_storeu_si128((__m128i *)(data + i), _mm_xor_si128(block, _mm_and_si128(inRange, bit16)));
+  }
+#  endif
+  for (; i < length; i++) {
+    if ((u8)(data[i] - first) < 26) {
+      data[i] ^= 0x20;
+    }
+  }
+}
+
+static inline u8 strFoldByte(u8 c) {
+  return (u8)(c - 'A') < 26 ? c | 0x20 : c;
+}
+
+#  if defined(BASE_SSE2)
+static inline __m128i strFold16(__m128i block) {
+  __m128i inRange = _mm_cmplt_epi8(_mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - 'A'))), _mm_set1_epi8(-128 + 26));
+  return _mm_or_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+#  endif
+
+// Index of the first byte that differs ignoring ASCII case, `length` when there is none
+static size_t strMismatchNoCase(const u8 *a, const u8 *b, size_t length) {
+  size_t i = 0;
+#  if defined(BASE_SSE2)
+  for (; i + 16 <= length; i += 16) {
+    __m128i blockA = strFold16(_mm_loadu_si128((const __m128i *)(a + i)));
+    __m128i blockB = strFold16(_mm_loadu_si128((const __m128i *)(b + i)));
+    u32 equal = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB));
+    if (equal != 0xFFFF) {
+      return i + __BitCtz64(~equal & 0xFFFF);
+    }
+  }
+#  endif
+  for (; i < length; i++) {
+    if (strFoldByte(a[i]) != strFoldByte(b[i])) {
+      return i;
+    }
+  }
+  return length;
+}
+
+void StrToUpper(String *str) {
+  strCaseFlip(str->data, str->length, 'a');
+}
+
+void StrToLower(String *str) {
+  strCaseFlip(str->data, str->length, 'A');
+}
+
+bool StrEqualNoCase(String *string1, String *string2) {
+  if (string1->length != string2->length) {
+    return false;
+  }
+  return strMismatchNoCase((const u8 *)string1->data, (const u8 *)string2->data, string1->length) == string1->length;
+}
+
+i32 StrCompareNoCase(String *string1, String *string2) {
+  size_t length = Min(string1->length, string2->length);
+  size_t i = strMismatchNoCase((const u8 *)string1->data, (const u8 *)string2->data, length);
+  if (i < length) {
+    return (i32)strFoldByte((u8)string1->data[i]) - (i32)strFoldByte((u8)string2->data[i]);
+  }
+  return (string1->length > string2->length) - (string1->length < string2->length);
+}
+
+// NOTE: Same set as `isspace` in the C locale
+static const bool strSpaceTable[256] = {['\t'] = true, ['\n'] = true, ['\v'] = true, ['\f'] = true, ['\r'] = true, [' '] = true};
+
+bool isSpace(char character) {
+  return strSpaceTable[(u8)character];
+}
+
+String StrTrimLeft(String *str) {
+  size_t start = 0;
+  while (start < str->length && strSpaceTable[(u8)str->data[start]]) {
+    start++;
+  }
+  return (String){.length = str->length - start, .data = str->data + start};
+}
+
+String StrTrimRight(String *str) {
+  size_t length = str->length;
+  while (length > 0 && strSpaceTable[(u8)str->data[length - 1]]) {
+    length--;
+  }
+  return (String){.length = length, .data = str->data};
+}
+
+String StrTrimView(String *str) {
+  String left = StrTrimLeft(str);
+  return StrTrimRight(&left);
+}
+
+void StrTrim(String *str) {
+  String trimmed = StrTrimView(str);
+  if (trimmed.length == str->length) {
+    return;
+  }
+
+  memmove(str->data, trimmed.data, trimmed.length); // NOTE: Overlapping, the content only ever moves back
+  str->length = trimmed.length;
+  addNullTerminator(str->data, trimmed.length);
+}
+
+String StrSlice(Arena *arena, String *str, size_t start, size_t end) {
+  assert(start >= 0 && "StrSlice: start index must be non-negative");
+  assert(start <= str->length && "StrSlice: start index out of bounds");
+
+  if (end < 0) {
+    end = str->length + end;
+  }
+
+  assert(end >= start && "StrSlice: end must be greater than or equal to start");
+  assert(end <= str->length && "StrSlice: end index out of bounds");
+
+  size_t len = end - start;
+  return StrNewSize(arena, str->data + start, len);
+}
+
+String F(Arena *arena, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list retry;
+  va_copy(retry, args);
+
+  // NOTE: Format straight into the rest of the current chunk, only a result that doesn't fit formats twice
+  char *buffer = arena->current->buffer + arena->offset;
+  size_t available = arena->current->cap - arena->offset;
+  i32 result = vsnprintf(buffer, available, format, args);
+  size_t length = result < 0 ? 0 : (size_t)result;
+  if (result < 0) {
+    buffer = ArenaAllocChars(arena, 1); // NOTE: Encoding error, nothing usable was written
+  } else if (length < available) {
+    arena->offset += length + 1;
+  } else {
+    buffer = ArenaAllocChars(arena, length + 1);
+    vsnprintf(buffer, length + 1, format, retry);
+  }
+  va_end(retry);
+  va_end(args);
+
+  return (String){.length = length, .data = buffer};
+}
+
+String ConvertPath(Arena *arena, String path) {
+  String platform = GetPlatform();
+  String result;
+
+  if (path.length >= 2 && path.data[0] == '.' && (path.data[1] == '/' || path.data[1] == '\\')) {
+    result = StrNewSize(arena, path.data + 2, path.length - 2);
+    memcpy(result.data, path.data + 2, path.length - 2);
+  } else {
+    result = StrNewSize(arena, path.data, path.length);
+  }
+
+  if (StrEqual(&platform, &S("linux")) || StrEqual(&platform, &S("macos"))) {
+    return result;
+  }
+
+  for (size_t i = 0; i < result.length; i++) {
+    if (result.data[i] == '/') {
+      result.data[i] = '\\';
+    }
+  }
+
+  return result;
+}
+
+String ParsePath(Arena *arena, String path) {
+  String result;
+
+  if (path.length >= 2 && path.data[0] == '.' && (path.data[1] == '/' || path.data[1] == '\\')) {
+    result = StrNewSize(arena, path.data + 2, path.length - 2);
+    memcpy(result.data, path.data + 2, path.length - 2);
+  } else {
+    result = StrNewSize(arena, path.data, path.length);
+  }
+
+  return result;
+}
+
+String ConvertExe(Arena *arena, String path) {
+  String platform = GetPlatform();
+  String exeExtension = S(".exe");
+
+  bool hasExe = false;
+  if (path.length >= exeExtension.length) {
+    String pathEnd = StrSlice(arena, &path, path.length - exeExtension.length, path.length);
+    if (StrEqual(&pathEnd, &exeExtension)) {
+      hasExe = true;
+    }
+  }
+
+  if (StrEqual(&platform, &S("windows"))) {
+    if (hasExe) {
+      return path;
+    }
+    return StrConcat(arena, &path, &exeExtension);
+  }
+
+  if (StrEqual(&platform, &S("linux")) || StrEqual(&platform, &S("macos"))) {
+    if (hasExe) {
+      return StrSlice(arena, &path, 0, path.length - exeExtension.length);
+    }
+    return path;
+  }
+
+  return path;
+}
+
+/* String Builder Implementation */
+StringBuilder StrBuilderNew(Arena *arena, size_t capacity) {
+  StringBuilder builder = {.arena = arena};
+  StrBuilderReserve(&builder, capacity);
+  return builder;
+}
+
+// True when the builder buffer ends exactly where the arena's next allocation would start
+static bool strBuilderIsArenaTop(StringBuilder *builder) {
+  Arena *arena = builder->arena;
+  return builder->data + builder->capacity + 1 == arena->current->buffer + arena->offset;
+}
+
+void StrBuilderReserve(StringBuilder *builder, size_t additional) {
+  size_t required = builder->length + additional;
+  if (builder->data && required <= builder->capacity) {
+    return;
+  }
+
+  size_t capacity = Max(Max(builder->capacity * 2, required), 32);
+  if (!builder->arena) {
+    builder->data = Realloc(builder->data, capacity + 1);
+  } else if (builder->data && strBuilderIsArenaTop(builder) && builder->arena->offset + capacity - builder->capacity <= builder->arena->current->cap) {
+    builder->arena->offset += capacity - builder->capacity; // NOTE: Extend in place, nothing to copy
+  } else {
+    char *data = ArenaAllocChars(builder->arena, capacity + 1);
+    if (builder->length) memcpy(data, builder->data, builder->length);
+    builder->data = data;
+  }
+  builder->capacity = capacity;
+}
+
+void StrBuilderAppend(StringBuilder *builder, String *string) {
+  StrBuilderReserve(builder, string->length);
+  memcpy(builder->data + builder->length, string->data, string->length);
+  builder->length += string->length;
+}
+
+void StrBuilderAppendChar(StringBuilder *builder, char c) {
+  StrBuilderReserve(builder, 1);
+  builder->data[builder->length++] = c;
+}
+
+void StrBuilderAppendF(StringBuilder *builder, const char *format, ...) {
+  StrBuilderReserve(builder, 0);
+  va_list args;
+  va_start(args, format);
+  va_list retry;
+  va_copy(retry, args);
+
+  // NOTE: Format straight into the free space, only a result that doesn't fit formats twice
+  size_t available = builder->capacity - builder->length + 1;
+  i32 result = vsnprintf(builder->data + builder->length, available, format, args);
+  size_t written = result < 0 ? 0 : (size_t)result; // NOTE: Encoding errors append nothing
+  if (written >= available) {
+    StrBuilderReserve(builder, written);
+    vsnprintf(builder->data + builder->length, written + 1, format, retry);
+  }
+  builder->length += written;
+  va_end(retry);
+  va_end(args);
+}
+
+void StrBuilderAppendI64(StringBuilder *builder, i64 value) {
+  StrBuilderReserve(builder, STR_NUMBER_MAX);
+  builder->length += StrWriteI64(builder->data + builder->length, value);
+}
+
+void StrBuilderAppendF64(StringBuilder *builder, f64 value) {
+  StrBuilderReserve(builder, STR_NUMBER_MAX);
+  builder->length += StrWriteF64(builder->data + builder->length, value);
+}
+
+// Writes `value` in `base` right aligned into `buffer`, returns where the digits start
+static char *fmtDigits(char *bufferEnd, u64 value, u32 base, bool upper) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  char *cursor = bufferEnd;
+  do {
+    *--cursor = digits[value % base];
+    value /= base;
+  } while (value);
+  return cursor;
+}
+
+static void fmtPadded(StringBuilder *builder, const char *data, size_t length, size_t width, bool left, char pad) {
+  size_t padding = width > length ? width - length : 0;
+  StrBuilderReserve(builder, length + padding);
+  if (!left) {
+    memset(builder->data + builder->length, pad, padding);
+    builder->length += padding;
+  }
+  memcpy(builder->data + builder->length, data, length);
+  builder->length += length;
+  if (left) {
+    memset(builder->data + builder->length, ' ', padding);
+    builder->length += padding;
+  }
+}
+
+// Exact `fraction * scale` rounded to nearest with ties to even like libc, `fraction` in [0, 1) and
+// `scale` a power of ten up to 1e9, so the product of the mantissa and the scale fits in 83 bits
+static u64 fmtScaleFraction(f64 fraction, u64 scale, u64 integer) {
+  u64 bits;
+  memcpy(&bits, &fraction, sizeof(bits));
+  u32 exponent = (bits >> 52) & 0x7FF;
+  u64 mantissa = bits & ((1ULL << 52) - 1);
+  u32 shift = 1074;
+  if (exponent) {
+    mantissa |= 1ULL << 52;
+    shift = 1075 - exponent;
+  }
+  if (shift >= 84) {
+    return 0; // NOTE: Less than half a unit of the last digit
+  }
+
+  u64 low = (mantissa & 0xFFFFFFFF) * scale;
+  u64 high = (mantissa >> 32) * scale;
+  u64 productLow = low + (high << 32);
+  u64 productHigh = (high >> 32) + (productLow < low);
+
+  u64 quotient, remainderHigh, remainderLow, halfHigh, halfLow;
+  if (shift < 64) {
+    quotient = (productHigh << (64 - shift)) | (productLow >> shift);
+    remainderHigh = 0;
+    remainderLow = productLow & ((1ULL << shift) - 1);
+    halfHigh = 0;
+    halfLow = 1ULL << (shift - 1);
+  } else {
+    quotient = productHigh >> (shift - 64);
+    remainderHigh = productHigh & ((1ULL << (shift - 64)) - 1);
+    remainderLow = productLow;
+    halfHigh = shift > 64 ? 1ULL << (shift - 65) : 0;
+    halfLow = shift > 64 ? 0 : 1ULL << 63;
+  }
+
+  bool above = remainderHigh > halfHigh || (remainderHigh == halfHigh && remainderLow > halfLow);
+  bool tie = remainderHigh == halfHigh && remainderLow == halfLow;
+  // NOTE: The last printed digit is odd when `integer * scale + quotient` is
+  if (above || (tie && ((quotient + integer * scale) & 1))) {
+    quotient++;
+  }
+  return quotient;
+}
+
+typedef struct {
+  size_t width;
+  i32 precision; // NOTE: -1 when there is none
+  bool left;
+  bool zero;
+  bool plus;
+  bool space;
+  bool alternate;
+} __FmtSpec;
+
+// Sign or base prefix, zeros up to the precision, then the digits. Zero padding goes between the prefix and the
+// digits like libc does
+static void fmtNumber(StringBuilder *builder, const char *prefix, size_t prefixLength, const char *digits, size_t length, size_t zeros,
+                      size_t width, bool left, bool zero) {
+  size_t total = prefixLength + zeros + length;
+  size_t padding = width > total ? width - total : 0;
+  StrBuilderReserve(builder, total + padding);
+  char *out = builder->data + builder->length;
+  if (!left && !zero) {
+    memset(out, ' ', padding);
+    out += padding;
+  }
+  memcpy(out, prefix, prefixLength);
+  out += prefixLength;
+  if (!left && zero) {
+    zeros += padding;
+  }
+  memset(out, '0', zeros);
+  out += zeros;
+  memcpy(out, digits, length);
+  out += length;
+  if (left) {
+    memset(out, ' ', padding);
+    out += padding;
+  }
+  builder->length = out - builder->data;
+}
+
+static size_t fmtSign(char *prefix, bool negative, __FmtSpec *spec) {
+  if (negative) {
+    prefix[0] = '-';
+  } else if (spec->plus) {
+    prefix[0] = '+';
+  } else if (spec->space) {
+    prefix[0] = ' ';
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+static void fmtInteger(StringBuilder *builder, u64 magnitude, bool negative, bool isSigned, u32 base, bool upper, __FmtSpec *spec) {
+  char buffer[24];
+  char *end = buffer + sizeof(buffer);
+  char *start = end;
+  if (magnitude != 0 || spec->precision != 0) { // NOTE: `%.0d` of 0 prints no digits at all
+    start = fmtDigits(end, magnitude, base, upper);
+  }
+  size_t length = end - start;
+  size_t zeros = spec->precision > (i32)length ? spec->precision - length : 0;
+
+  char prefix[3];
+  size_t prefixLength = isSigned ? fmtSign(prefix, negative, spec) : 0;
+  if (spec->alternate && base == 16 && magnitude != 0) {
+    prefix[prefixLength++] = '0';
+    prefix[prefixLength++] = upper ? 'X' : 'x';
+  }
+  if (spec->alternate && base == 8 && zeros == 0 && (length == 0 || *start != '0')) {
+    zeros = 1;
+  }
+  fmtNumber(builder, prefix, prefixLength, start, length, zeros, spec->width, spec->left, spec->zero && spec->precision < 0);
+}
+
+// Conversions left to libc keep every flag, the result is formatted straight into the builder
+static void fmtLibc(StringBuilder *builder, __FmtSpec *spec, char conversion, f64 value) {
+  char format[12];
+  char *cursor = format;
+  *cursor++ = '%';
+  if (spec->left) *cursor++ = '-';
+  if (spec->plus) *cursor++ = '+';
+  if (spec->space) *cursor++ = ' ';
+  if (spec->alternate) *cursor++ = '#';
+  if (spec->zero) *cursor++ = '0';
+  memcpy(cursor, "*.*", 3);
+  cursor += 3;
+  *cursor++ = conversion;
+  *cursor = '\0';
+
+  i32 width = (i32)Min(spec->width, (size_t)INT_MAX);
+  i32 length = snprintf(NULL, 0, format, width, spec->precision, value);
+  if (length < 0) {
+    return;
+  }
+  StrBuilderReserve(builder, length);
+  snprintf(builder->data + builder->length, length + 1, format, width, spec->precision, value);
+  builder->length += length;
+}
+
+static void fmtFloat(StringBuilder *builder, f64 value, char conversion, __FmtSpec *spec) {
+  static const u64 powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  i32 precision = spec->precision < 0 ? 6 : spec->precision;
+  f64 magnitude = value < 0 ? -value : value;
+  if (precision > 9 || !(magnitude < 1e15)) {
+    // NOTE: Large values, NaN and infinity are rare enough to leave to libc
+    fmtLibc(builder, spec, conversion, value);
+    return;
+  }
+
+  u64 integer = (u64)magnitude;
+  u64 fraction = fmtScaleFraction(magnitude - (f64)integer, powers[precision], integer);
+  if (fraction >= powers[precision]) {
+    integer++;
+    fraction -= powers[precision];
+  }
+
+  char buffer[32];
+  char *end = buffer + sizeof(buffer);
+  char *start = end;
+  if (precision) {
+    start = fmtDigits(end, fraction, 10, false);
+    while (end - start < precision) *--start = '0';
+    *--start = '.';
+  } else if (spec->alternate) {
+    *--start = '.';
+  }
+  start = fmtDigits(start, integer, 10, false);
+  u64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  char prefix[1];
+  size_t prefixLength = fmtSign(prefix, bits >> 63, spec); // NOTE: Sign bit, libc prints `-0.00` for tiny negatives and -0.0 too
+  fmtNumber(builder, prefix, prefixLength, start, end - start, 0, spec->width, spec->left, spec->zero);
+}
+
+static void fmtV(StringBuilder *builder, const char *format, va_list args) {
+  for (const char *cursor = format; *cursor;) {
+    if (*cursor != '%') {
+      const char *next = strchr(cursor, '%');
+      size_t length = next ? (size_t)(next - cursor) : strlen(cursor);
+      fmtPadded(builder, cursor, length, 0, false, ' ');
+      cursor += length;
+      continue;
+    }
+    const char *directive = cursor++;
+
+    __FmtSpec spec = {.precision = -1};
+    for (;; cursor++) {
+      if (*cursor == '-') spec.left = true;
+      else if (*cursor == '0') spec.zero = true;
+      else if (*cursor == '+') spec.plus = true;
+      else if (*cursor == ' ') spec.space = true;
+      else if (*cursor == '#') spec.alternate = true;
+      else break;
+    }
+
+    if (*cursor == '*') {
+      i32 value = va_arg(args, i32);
+      if (value < 0) spec.left = true;
+      spec.width = value < 0 ? -(i64)value : value;
+      cursor++;
+    }
+    while (*cursor >= '0' && *cursor <= '9') spec.width = spec.width * 10 + (*cursor++ - '0');
+
+    if (*cursor == '.') {
+      cursor++;
+      spec.precision = 0;
+      if (*cursor == '*') {
+        i32 value = va_arg(args, i32);
+        spec.precision = value < 0 ? -1 : value; // NOTE: A negative precision counts as none
+        cursor++;
+      }
+      while (*cursor >= '0' && *cursor <= '9') spec.precision = spec.precision * 10 + (*cursor++ - '0');
+    }
+    spec.zero &= !spec.left;
+
+    size_t size = sizeof(i32); // NOTE: Bytes of the integer argument
+    if (*cursor == 'h') {
+      size = *++cursor == 'h' ? (cursor++, sizeof(i8)) : sizeof(i16);
+    } else if (*cursor == 'l') {
+      size = *++cursor == 'l' ? (cursor++, sizeof(long long)) : sizeof(long);
+    } else if (*cursor == 'z' || *cursor == 'j' || *cursor == 't') {
+      size = *cursor++ == 'j' ? sizeof(intmax_t) : sizeof(size_t);
+    }
+
+    char conversion = *cursor;
+    if (conversion) cursor++;
+    switch (conversion) {
+    case 'd':
+    case 'i': {
+      i64 value = size == sizeof(i64) ? va_arg(args, i64) : va_arg(args, i32);
+      if (size == sizeof(i16)) value = (i16)value;
+      if (size == sizeof(i8)) value = (i8)value;
+      fmtInteger(builder, value < 0 ? -(u64)value : (u64)value, value < 0, true, 10, false, &spec);
+      break;
+    }
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X': {
+      u64 value = size == sizeof(u64) ? va_arg(args, u64) : va_arg(args, u32);
+      if (size == sizeof(u16)) value = (u16)value;
+      if (size == sizeof(u8)) value = (u8)value;
+      u32 base = conversion == 'u' ? 10 : conversion == 'o' ? 8 : 16;
+      fmtInteger(builder, value, false, false, base, conversion == 'X', &spec);
+      break;
+    }
+    case 'p': {
+      void *value = va_arg(args, void *);
+      if (!value) {
+        fmtPadded(builder, "(nil)", 5, spec.width, spec.left, ' ');
+        break;
+      }
+      spec.alternate = true;
+      fmtInteger(builder, (uintptr_t)value, false, true, 16, false, &spec);
+      break;
+    }
+    case 'c': {
+      char c = (char)va_arg(args, i32);
+      fmtPadded(builder, &c, 1, spec.width, spec.left, ' ');
+      break;
+    }
+    case 's': {
+      const char *value = va_arg(args, const char *);
+      if (!value) value = "(null)";
+      size_t length = spec.precision >= 0 ? strnlen(value, spec.precision) : strlen(value);
+      fmtPadded(builder, value, length, spec.width, spec.left, ' ');
+      break;
+    }
+    case 'S': {
+      String *value = va_arg(args, String *);
+      size_t length = spec.precision >= 0 ? Min(value->length, (size_t)spec.precision) : value->length;
+      fmtPadded(builder, value->data, length, spec.width, spec.left, ' ');
+      break;
+    }
+    case 'f':
+    case 'F':
+      fmtFloat(builder, va_arg(args, f64), conversion, &spec);
+      break;
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      fmtLibc(builder, &spec, conversion, va_arg(args, f64));
+      break;
+    case '%':
+      StrBuilderAppendChar(builder, '%');
+      break;
+    default:
+      // NOTE: Copied as written, without knowing its type the argument can't be skipped, so later ones shift
+      fmtPadded(builder, directive, cursor - directive, 0, false, ' ');
+      break;
+    }
+  }
+}
+
+String Fmt(Arena *arena, const char *format, ...) {
+  StringBuilder builder = StrBuilderNew(arena, 0);
+  va_list args;
+  va_start(args, format);
+  fmtV(&builder, format, args);
+  va_end(args);
+  return StrBuilderFinish(&builder);
+}
+
+void StrBuilderAppendFmt(StringBuilder *builder, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  fmtV(builder, format, args);
+  va_end(args);
+}
+
+String StrBuilderFinish(StringBuilder *builder) {
+  StrBuilderReserve(builder, 0);
+  builder->data[builder->length] = '\0';
+  String result = {.length = builder->length, .data = builder->data};
+  if (builder->arena) {
+    // NOTE: Give back the unused tail when nothing was allocated after the builder
+    if (strBuilderIsArenaTop(builder)) {
+      builder->arena->offset -= builder->capacity - builder->length;
+    }
+    Arena *arena = builder->arena;
+    memset(builder, 0, sizeof(*builder));
+    builder->arena = arena;
+  }
+  return result;
+}
+
+void StrBuilderFree(StringBuilder *builder) {
+  if (!builder->arena) {
+    Free(builder->data);
+  }
+  Arena *arena = builder->arena;
+  memset(builder, 0, sizeof(*builder));
+  builder->arena = arena;
+}
+
+/* String Matcher Implementation */
+#  define __STR_TEDDY_MAX_PATTERNS 32
+
+struct __StrMatcherDfa {
+  u32 *transitions; // NOTE: `classCount` entries per state, state ids are premultiplied by `classCount`
+  u32 *outputStart; // NOTE: Match state `s` reports `outputs[outputStart[k]]` up to `outputStart[k + 1]`, k = (s - matchStart) / classCount
+  u32 *outputs;
+  u32 classCount;
+  u32 matchStart; // NOTE: Match states are numbered last, so a single compare tells if a state reports anything
+  u8 classes[256];
+  u8 startBytes[3]; // NOTE: First bytes of every pattern when there are at most 3 of them
+  u8 startByteCount;
+};
+
+struct __StrMatcherTeddy {
+  u8 low[3][16]; // NOTE: Buckets with a pattern whose byte `k` has this low nibble
+  u8 high[3][16];
+  u32 fingerprint; // NOTE: Leading bytes checked by the filter, the shortest pattern length up to 3
+  u32 bucketStart[9];
+  u32 bucketPatterns[__STR_TEDDY_MAX_PATTERNS];
+};
+
+static __StrMatcherDfa *strMatcherDfaNew(Arena *arena, String *patterns, u32 count) {
+  __StrMatcherDfa *dfa = (__StrMatcherDfa *)ArenaAlloc(arena, sizeof(__StrMatcherDfa));
+
+  // NOTE: Bytes that appear in no pattern all behave the same and share one class, every other byte gets its own
+  bool used[256] = {0};
+  bool first[256] = {0};
+  size_t maxStates = 1;
+  for (u32 p = 0; p < count; p++) {
+    for (size_t j = 0; j < patterns[p].length; j++) {
+      used[(u8)patterns[p].data[j]] = true;
+    }
+    first[(u8)patterns[p].data[0]] = true;
+    maxStates += patterns[p].length;
+  }
+  u32 classCount = 0;
+  i32 unusedClass = -1;
+  for (u32 b = 0; b < 256; b++) {
+    if (used[b]) {
+      dfa->classes[b] = classCount++;
+    } else {
+      if (unusedClass < 0) unusedClass = classCount++;
+      dfa->classes[b] = unusedClass;
+    }
+    if (first[b] && dfa->startByteCount < 4) {
+      if (dfa->startByteCount < 3) dfa->startBytes[dfa->startByteCount] = b;
+      dfa->startByteCount++;
+    }
+  }
+  if (dfa->startByteCount > 3) {
+    dfa->startByteCount = 0;
+  }
+  dfa->classCount = classCount;
+  assert(maxStates * classCount <= UINT32_MAX && "StrMatcherNew: Too many patterns for a single matcher");
+
+  // NOTE: Trie first, state 0 is the root so a 0 transition means no child yet
+  u32 *trie = (u32 *)Malloc(maxStates * classCount * sizeof(u32));
+  u32 *fail = (u32 *)Malloc(maxStates * sizeof(u32));
+  u32 *matchCount = (u32 *)Malloc(maxStates * sizeof(u32));
+  u32 *ownHead = (u32 *)Malloc(maxStates * sizeof(u32)); // NOTE: Pattern + 1 ending exactly here, 0 for none
+  u32 *ownNext = (u32 *)Malloc(count * sizeof(u32));
+  memset(trie, 0, maxStates * classCount * sizeof(u32));
+  memset(ownHead, 0, maxStates * sizeof(u32));
+  u32 stateCount = 1;
+  for (u32 p = 0; p < count; p++) {
+    u32 state = 0;
+    for (size_t j = 0; j < patterns[p].length; j++) {
+      u32 *child = &trie[state * classCount + dfa->classes[(u8)patterns[p].data[j]]];
+      if (*child == 0) {
+        *child = stateCount++;
+      }
+      state = *child;
+    }
+    ownNext[p] = ownHead[state];
+    ownHead[state] = p + 1;
+  }
+
+  // NOTE: Breadth first, a state's failure link is always finished before its children need it, missing
+  // transitions are filled from the failure state which turns the trie into the DFA in place
+  u32 *queue = (u32 *)Malloc(stateCount * sizeof(u32));
+  size_t head = 0;
+  size_t tail = 0;
+  fail[0] = 0;
+  matchCount[0] = 0;
+  queue[tail++] = 0;
+  while (head < tail) {
+    u32 state = queue[head++];
+    for (u32 c = 0; c < classCount; c++) {
+      u32 *child = &trie[state * classCount + c];
+      if (*child) {
+        u32 link = state == 0 ? 0 : trie[fail[state] * classCount + c];
+        fail[*child] = link;
+        matchCount[*child] = matchCount[link];
+        for (u32 own = ownHead[*child]; own; own = ownNext[own - 1]) {
+          matchCount[*child]++;
+        }
+        queue[tail++] = *child;
+      } else if (state != 0) {
+        *child = trie[fail[state] * classCount + c];
+      }
+    }
+  }
+
+  // NOTE: Renumber so states without matches come first, in breadth first order which keeps the root at 0
+  u32 *renamed = (u32 *)Malloc(stateCount * sizeof(u32));
+  u32 *order = queue; // NOTE: Reused, new id -> old id
+  u32 plain = 0;
+  u32 outputTotal = 0;
+  for (size_t i = 0; i < stateCount; i++) {
+    if (matchCount[queue[i]] == 0) {
+      renamed[queue[i]] = plain++;
+    } else {
+      outputTotal += matchCount[queue[i]];
+    }
+  }
+  u32 matching = plain;
+  for (size_t i = 0; i < stateCount; i++) {
+    if (matchCount[queue[i]] != 0) {
+      renamed[queue[i]] = matching++;
+    }
+  }
+  for (size_t i = 0; i < stateCount; i++) {
+    order[renamed[i]] = i;
+  }
+
+  dfa->matchStart = plain * classCount;
+  dfa->transitions = (u32 *)ArenaAlloc(arena, (size_t)stateCount * classCount * sizeof(u32));
+  for (u32 state = 0; state < stateCount; state++) {
+    u32 *row = &dfa->transitions[state * classCount];
+    u32 *old = &trie[order[state] * classCount];
+    for (u32 c = 0; c < classCount; c++) {
+      row[c] = renamed[old[c]] * classCount;
+    }
+  }
+
+  // NOTE: Walking the failure chain lists the longest pattern first, so matches ending together start in order
+  dfa->outputStart = (u32 *)ArenaAlloc(arena, (stateCount - plain + 1) * sizeof(u32));
+  dfa->outputs = (u32 *)ArenaAlloc(arena, Max(outputTotal, 1) * sizeof(u32));
+  u32 written = 0;
+  for (u32 state = plain; state < stateCount; state++) {
+    dfa->outputStart[state - plain] = written;
+    for (u32 link = order[state]; link; link = fail[link]) {
+      for (u32 own = ownHead[link]; own; own = ownNext[own - 1]) {
+        dfa->outputs[written++] = own - 1;
+      }
+    }
+  }
+  dfa->outputStart[stateCount - plain] = written;
+
+  Free(trie);
+  Free(fail);
+  Free(matchCount);
+  Free(ownHead);
+  Free(ownNext);
+  Free(queue);
+  Free(renamed);
+  return dfa;
+}
+
+// Next position from `i` holding the first byte of some pattern, `length` if there is none
+static size_t strMatcherSkip(__StrMatcherDfa *dfa, const u8 *data, size_t i, size_t length) {
+  if (dfa->startByteCount == 1) {
+    const u8 *found = (const u8 *)memchr(data + i, dfa->startBytes[0], length - i);
+    return found ? (size_t)(found - data) : length;
+  }
+  u8 first = dfa->startBytes[0];
+  u8 second = dfa->startBytes[1];
+  u8 third = dfa->startBytes[dfa->startByteCount - 1];
+#  if defined(BASE_SSE2)
+  __m128i first16 = _mm_set1_epi8(first);
+  __m128i second16 = _mm_set1_epi8(second);
+  __m128i third16 = _mm_set1_epi8(third);
+  for (; i + 16 <= length; i += 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+    __m128i found = _mm_or_si128(_mm_cmpeq_epi8(block, first16), _mm_or_si128(_mm_cmpeq_epi8(block, second16), _mm_cmpeq_epi8(block, third16)));
+    u32 mask = (u32)_mm_movemask_epi8(found);
+    if (mask) {
+      return i + __BitCtz64(mask);
+    }
+  }
+#  endif
+  for (; i < length; i++) {
+    if (data[i] == first || data[i] == second || data[i] == third) {
+      return i;
+    }
+  }
+  return length;
+}
+
+static bool strMatcherDfaScan(StrMatcher *matcher, String *text, StrMatchVector *matches) {
+  __StrMatcherDfa *dfa = matcher->dfa;
+  const u8 *data = (const u8 *)text->data;
+  size_t length = text->length;
+  bool found = false;
+  u32 state = 0;
+  for (size_t i = 0; i < length; i++) {
+    if (state == 0 && dfa->startByteCount) {
+      i = strMatcherSkip(dfa, data, i, length);
+      if (i == length) {
+        break;
+      }
+    }
+    state = dfa->transitions[state + dfa->classes[data[i]]];
+    if (_BASE_UNLIKELY(state >= dfa->matchStart)) {
+      if (!matches) {
+        return true;
+      }
+      found = true;
+      u32 k = (state - dfa->matchStart) / dfa->classCount;
+      for (u32 o = dfa->outputStart[k]; o < dfa->outputStart[k + 1]; o++) {
+        u32 pattern = dfa->outputs[o];
+        StrMatch match = {.pattern = pattern, .offset = i + 1 - matcher->patterns[pattern].length};
+        VecPush((*matches), match);
+      }
+    }
+  }
+  return found;
+}
+
+static __StrMatcherTeddy *strMatcherTeddyNew(Arena *arena, String *patterns, u32 count, size_t minLength) {
+  __StrMatcherTeddy *teddy = (__StrMatcherTeddy *)ArenaAlloc(arena, sizeof(__StrMatcherTeddy));
+  teddy->fingerprint = Min(minLength, 3);
+
+  // NOTE: Sorted by fingerprint and cut in 8 runs, patterns with similar prefixes share a bucket
+  // which keeps the buckets a candidate lights up (and so the patterns to verify) few
+  u32 *order = teddy->bucketPatterns;
+  for (u32 i = 0; i < count; i++) {
+    u32 pattern = i;
+    u32 j = i;
+    for (; j > 0 && memcmp(patterns[order[j - 1]].data, patterns[pattern].data, teddy->fingerprint) > 0; j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = pattern;
+  }
+  for (u32 bucket = 0; bucket <= 8; bucket++) {
+    teddy->bucketStart[bucket] = (bucket * count + 7) / 8;
+  }
+  for (u32 rank = 0; rank < count; rank++) {
+    u8 bit = 1 << (rank * 8 / count);
+    for (u32 k = 0; k < teddy->fingerprint; k++) {
+      u8 byte = (u8)patterns[order[rank]].data[k];
+      teddy->low[k][byte & 0x0F] |= bit;
+      teddy->high[k][byte >> 4] |= bit;
+    }
+  }
+  return teddy;
+}
+
+static bool strMatcherTeddyVerify(StrMatcher *matcher, const u8 *data, size_t length, size_t position, u32 buckets, StrMatchVector *matches) {
+  __StrMatcherTeddy *teddy = matcher->teddy;
+  bool found = false;
+  while (buckets) {
+    u32 bucket = __BitCtz64(buckets);
+    buckets &= buckets - 1;
+    for (u32 rank = teddy->bucketStart[bucket]; rank < teddy->bucketStart[bucket + 1]; rank++) {
+      u32 pattern = teddy->bucketPatterns[rank];
+      String *needle = &matcher->patterns[pattern];
+      if (needle->length <= length - position && memcmp(data + position, needle->data, needle->length) == 0) {
+        if (!matches) {
+          return true;
+        }
+        found = true;
+        StrMatch match = {.pattern = pattern, .offset = position};
+        VecPush((*matches), match);
+      }
+    }
+  }
+  return found;
+}
+
+static bool strMatcherTeddyScan(StrMatcher *matcher, String *text, StrMatchVector *matches) {
+  __StrMatcherTeddy *teddy = matcher->teddy;
+  const u8 *data = (const u8 *)text->data;
+  size_t length = text->length;
+  size_t span = teddy->fingerprint - 1; // NOTE: Extra bytes read past a candidate position
+  bool found = false;
+  size_t i = 0;
+#  if defined(BASE_AVX2)
+  // NOTE: Each fingerprint byte looks up the buckets of its low and high nibble, a position stays a candidate
+  // while every byte agrees on some bucket
+  __m256i nibble = _mm256_set1_epi8(0x0F);
+  __m256i low[3];
+  __m256i high[3];
+  for (u32 k = 0; k < teddy->fingerprint; k++) {
+    low[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)teddy->low[k]));
+    high[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)teddy->high[k]));
+  }
+  for (; i + 32 + span <= length; i += 32) {
+    __m256i candidates = _mm256_set1_epi8(-1);
+    for (u32 k = 0; k < teddy->fingerprint; k++) {
+      __m256i block = _mm256_loadu_si256((const __m256i *)(data + i + k));
+      __m256i lowBuckets = _mm256_shuffle_epi8(low[k], _mm256_and_si256(block, nibble));
+      __m256i highBuckets = _mm256_shuffle_epi8(high[k], _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+      candidates = _mm256_and_si256(candidates, _mm256_and_si256(lowBuckets, highBuckets));
+    }
+    u32 mask = ~(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(candidates, _mm256_setzero_si256()));
+    if (mask == 0) {
+      continue;
+    }
+    u8 buckets[32];
+    _mm256_storeu_si256((__m256i *)buckets, candidates);
+    while (mask) {
+      u32 bit = __BitCtz64(mask);
+      mask &= mask - 1;
+      if (strMatcherTeddyVerify(matcher, data, length, i + bit, buckets[bit], matches)) {
+        if (!matches) {
+          return true;
+        }
+        found = true;
+      }
+    }
+  }
+#  endif
+  for (; i + span < length; i++) {
+    u32 buckets = 0xFF;
+    for (u32 k = 0; k < teddy->fingerprint; k++) {
+      u8 byte = data[i + k];
+      buckets &= teddy->low[k][byte & 0x0F] & teddy->high[k][byte >> 4];
+    }
+    if (buckets && strMatcherTeddyVerify(matcher, data, length, i, buckets, matches)) {
+      if (!matches) {
+        return true;
+      }
+      found = true;
+    }
+  }
+  return found;
+}
+
+StrMatcher StrMatcherNew(Arena *arena, StringVector *patterns) {
+  assert(patterns->length <= UINT32_MAX && "StrMatcherNew: Too many patterns for a single matcher");
+  StrMatcher matcher = {.patternCount = (u32)patterns->length};
+  matcher.patterns = (String *)ArenaAlloc(arena, Max(patterns->length, 1) * sizeof(String));
+  size_t minLength = SIZE_MAX;
+  for (size_t i = 0; i < patterns->length; i++) {
+    String *pattern = &patterns->data[i];
+    assert(pattern->length > 0 && "StrMatcherNew: patterns should never be empty");
+    matcher.patterns[i] = StrNewSize(arena, pattern->data, pattern->length);
+    minLength = Min(minLength, pattern->length);
+  }
+
+  // NOTE: Teddy needs a byte shuffle, which SSE2 doesn't have, and a one byte fingerprint filters too little
+  bool teddy = matcher.patternCount > 0 && matcher.patternCount <= __STR_TEDDY_MAX_PATTERNS && minLength >= 2;
+#  if !defined(BASE_AVX2)
+  teddy = false;
+#  endif
+  if (teddy) {
+    matcher.teddy = strMatcherTeddyNew(arena, matcher.patterns, matcher.patternCount, minLength);
+  } else {
+    matcher.dfa = strMatcherDfaNew(arena, matcher.patterns, matcher.patternCount);
+  }
+  return matcher;
+}
+
+static inline bool strMatchBefore(StrMatch *a, StrMatch *b) {
+  return a->offset < b->offset || (a->offset == b->offset && a->pattern < b->pattern);
+}
+
+// Bottom up merge sort by offset then pattern. The DFA reports matches by end and Teddy groups them by bucket,
+// how far one is from its place depends on how many other matches overlap it (think `a`, `aa`, `aaa`... over
+// a run of `a`), so anything quadratic blows up
+static void strMatchSort(StrMatch *matches, size_t count) {
+  size_t sorted = 1;
+  while (sorted < count && !strMatchBefore(&matches[sorted], &matches[sorted - 1])) {
+    sorted++;
+  }
+  if (sorted >= count) {
+    return;
+  }
+
+  StrMatch *buffer = (StrMatch *)Malloc(count * sizeof(StrMatch));
+  StrMatch *from = matches;
+  StrMatch *to = buffer;
+  for (size_t width = 1; width < count; width *= 2) {
+    for (size_t start = 0; start < count; start += 2 * width) {
+      size_t middle = Min(start + width, count);
+      size_t end = Min(start + 2 * width, count);
+      size_t left = start;
+      size_t right = middle;
+      size_t out = start;
+      while (left < middle && right < end) {
+        to[out++] = strMatchBefore(&from[right], &from[left]) ? from[right++] : from[left++];
+      }
+      while (left < middle) to[out++] = from[left++];
+      while (right < end) to[out++] = from[right++];
+    }
+    StrMatch *swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from != matches) {
+    memcpy(matches, from, count * sizeof(StrMatch));
+  }
+  Free(buffer);
+}
+
+StrMatchVector StrMatcherFindAll(StrMatcher *matcher, String *text) {
+  StrMatchVector matches = {0};
+  if (matcher->teddy) {
+    strMatcherTeddyScan(matcher, text, &matches);
+  } else {
+    strMatcherDfaScan(matcher, text, &matches);
+  }
+
+  strMatchSort(matches.data, matches.length);
+  return matches;
+}
+
+bool StrMatcherContains(StrMatcher *matcher, String *text) {
+  if (matcher->teddy) {
+    return strMatcherTeddyScan(matcher, text, NULL);
+  }
+  return strMatcherDfaScan(matcher, text, NULL);
+}
+
+/* UTF-8 Implementation */
+// Length of the well formed sequence at `p` and its codepoint, 0 when it's invalid or cut short
+static inline u32 utf8Decode(const u8 *p, size_t remaining, u32 *codepoint) {
+  u8 lead = p[0];
+  if (lead < 0x80) {
+    *codepoint = lead;
+    return 1;
+  }
+  if (lead < 0xC2) { // NOTE: A continuation byte or the start of an overlong 2 byte form
+    return 0;
+  }
+  if (lead < 0xE0) {
+    if (remaining < 2 || (p[1] & 0xC0) != 0x80) {
+      return 0;
+    }
+    *codepoint = ((u32)(lead & 0x1F) << 6) | (p[1] & 0x3F);
+    return 2;
+  }
+  if (lead < 0xF0) {
+    if (remaining < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80) {
+      return 0;
+    }
+    u32 value = ((u32)(lead & 0x0F) << 12) | ((u32)(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+    if (value < 0x800 || (value >= 0xD800 && value <= 0xDFFF)) {
+      return 0;
+    }
+    *codepoint = value;
+    return 3;
+  }
+  if (lead < 0xF5) {
+    if (remaining < 4 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) {
+      return 0;
+    }
+    u32 value = ((u32)(lead & 0x07) << 18) | ((u32)(p[1] & 0x3F) << 12) | ((u32)(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    if (value < 0x10000 || value > 0x10FFFF) {
+      return 0;
+    }
+    *codepoint = value;
+    return 4;
+  }
+  return 0;
+}
+
+static inline u32 utf8Encode(u32 codepoint, u8 *out) {
+  if (codepoint < 0x80) {
+    out[0] = (u8)codepoint;
+    return 1;
+  }
+  if (codepoint < 0x800) {
+    out[0] = (u8)(0xC0 | (codepoint >> 6));
+    out[1] = (u8)(0x80 | (codepoint & 0x3F));
+    return 2;
+  }
+  if (codepoint < 0x10000) {
+    out[0] = (u8)(0xE0 | (codepoint >> 12));
+    out[1] = (u8)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[2] = (u8)(0x80 | (codepoint & 0x3F));
+    return 3;
+  }
+  out[0] = (u8)(0xF0 | (codepoint >> 18));
+  out[1] = (u8)(0x80 | ((codepoint >> 12) & 0x3F));
+  out[2] = (u8)(0x80 | ((codepoint >> 6) & 0x3F));
+  out[3] = (u8)(0x80 | (codepoint & 0x3F));
+  return 4;
+}
+
+// Bytes `codepoint` takes as UTF-8, 0 for surrogates and anything past U+10FFFF
+static inline u32 utf8EncodedSize(u32 codepoint) {
+  if (codepoint < 0x80) return 1;
+  if (codepoint < 0x800) return 2;
+  if (codepoint < 0x10000) return (codepoint >= 0xD800 && codepoint <= 0xDFFF) ? 0 : 3;
+  return codepoint <= 0x10FFFF ? 4 : 0;
+}
+
+#  if defined(BASE_AVX2) || defined(BASE_SSSE3)
+// NOTE: Keiser & Lemire lookup validation. Each error bit names a bad pattern in a pair of adjacent bytes, three
+// nibble lookups (high and low nibble of the previous byte, high nibble of the current one) are and'ed so only the
+// patterns all three agree on survive. Two continuations in a row are only right inside 3 and 4 byte sequences,
+// that bit is instead flipped where the byte 2 or 3 back says one is expected
+#    define __UTF8_TOO_SHORT (1 << 0)  // NOTE: Lead byte not followed by a continuation
+#    define __UTF8_TOO_LONG (1 << 1)   // NOTE: ASCII followed by a continuation
+#    define __UTF8_OVERLONG_3 (1 << 2) // NOTE: E0 80..9F
+#    define __UTF8_TOO_LARGE (1 << 3)  // NOTE: F4 90..BF, F5..FF
+#    define __UTF8_SURROGATE (1 << 4)  // NOTE: ED A0..BF
+#    define __UTF8_OVERLONG_2 (1 << 5) // NOTE: C0 and C1 leads
+#    define __UTF8_TOO_LARGE_1000 (1 << 6)
+#    define __UTF8_OVERLONG_4 (1 << 6) // NOTE: F0 80..8F
+#    define __UTF8_TWO_CONTS (1 << 7)
+#    define __UTF8_CARRY (__UTF8_TOO_SHORT | __UTF8_TOO_LONG | __UTF8_TWO_CONTS)
+// NOTE: One entry per nibble value, shared by the 16 and 32 byte versions
+#    define __UTF8_BYTE1_HIGH                                                                                   \
+      __UTF8_TOO_LONG, __UTF8_TOO_LONG, __UTF8_TOO_LONG, __UTF8_TOO_LONG, __UTF8_TOO_LONG, __UTF8_TOO_LONG,     \
+      __UTF8_TOO_LONG, __UTF8_TOO_LONG, __UTF8_TWO_CONTS, __UTF8_TWO_CONTS, __UTF8_TWO_CONTS, __UTF8_TWO_CONTS, \
+      __UTF8_TOO_SHORT | __UTF8_OVERLONG_2, __UTF8_TOO_SHORT,                                                   \
+      __UTF8_TOO_SHORT | __UTF8_OVERLONG_3 | __UTF8_SURROGATE,                                                  \
+      __UTF8_TOO_SHORT | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000 | __UTF8_OVERLONG_4
+#    define __UTF8_BYTE1_LOW                                                                                      \
+      __UTF8_CARRY | __UTF8_OVERLONG_3 | __UTF8_OVERLONG_2 | __UTF8_OVERLONG_4, __UTF8_CARRY | __UTF8_OVERLONG_2, \
+      __UTF8_CARRY, __UTF8_CARRY, __UTF8_CARRY | __UTF8_TOO_LARGE,                                                \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000 | __UTF8_SURROGATE,                                 \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000,                                                    \
+      __UTF8_CARRY | __UTF8_TOO_LARGE | __UTF8_TOO_LARGE_1000
+#    define __UTF8_BYTE2_HIGH                                                                                                 \
+      __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT,             \
+      __UTF8_TOO_SHORT, __UTF8_TOO_SHORT,                                                                                     \
+      __UTF8_TOO_LONG | __UTF8_OVERLONG_2 | __UTF8_TWO_CONTS | __UTF8_OVERLONG_3 | __UTF8_TOO_LARGE_1000 | __UTF8_OVERLONG_4, \
+      __UTF8_TOO_LONG | __UTF8_OVERLONG_2 | __UTF8_TWO_CONTS | __UTF8_OVERLONG_3 | __UTF8_TOO_LARGE,                          \
+      __UTF8_TOO_LONG | __UTF8_OVERLONG_2 | __UTF8_TWO_CONTS | __UTF8_SURROGATE | __UTF8_TOO_LARGE,                           \
+      __UTF8_TOO_LONG | __UTF8_OVERLONG_2 | __UTF8_TWO_CONTS | __UTF8_SURROGATE | __UTF8_TOO_LARGE,                           \
+      __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT, __UTF8_TOO_SHORT
+#  endif
+
+#  if defined(BASE_AVX2)
+#    define __UTF8_PREV(input, previous, n) _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - (n))
+
+static inline __m256i utf8CheckBlock(__m256i input, __m256i previous) {
+  const __m256i byte1HighTable = _mm256_setr_epi8(__UTF8_BYTE1_HIGH, __UTF8_BYTE1_HIGH);
+  const __m256i byte1LowTable = _mm256_setr_epi8(__UTF8_BYTE1_LOW, __UTF8_BYTE1_LOW);
+  const __m256i byte2HighTable = _mm256_setr_epi8(__UTF8_BYTE2_HIGH, __UTF8_BYTE2_HIGH);
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+  __m256i prev1 = __UTF8_PREV(input, previous, 1);
+  __m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, nibble));
+  __m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+  __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+  // NOTE: Only bytes 2 back from a 111_____ lead or 3 back from a 1111____ lead reach 0x80 here
+  __m256i third = _mm256_subs_epu8(__UTF8_PREV(input, previous, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(__UTF8_PREV(input, previous, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+  __m256i expected = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+  return _mm256_xor_si256(expected, special);
+}
+#  elif defined(BASE_SSSE3)
+// NOTE: Same checks 16 bytes at a time, the nibble lookups only need SSSE3's byte shuffle
+#    define __UTF8_PREV(input, previous, n) _mm_alignr_epi8(input, previous, 16 - (n))
+
+static inline __m128i utf8CheckBlock16(__m128i input, __m128i previous) {
+  const __m128i byte1HighTable = _mm_setr_epi8(__UTF8_BYTE1_HIGH);
+  const __m128i byte1LowTable = _mm_setr_epi8(__UTF8_BYTE1_LOW);
+  const __m128i byte2HighTable = _mm_setr_epi8(__UTF8_BYTE2_HIGH);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+
+  __m128i prev1 = __UTF8_PREV(input, previous, 1);
+  __m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, nibble));
+  __m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+  __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+  __m128i third = _mm_subs_epu8(__UTF8_PREV(input, previous, 2), _mm_set1_epi8((char)(0xE0 - 0x80)));
+  __m128i fourth = _mm_subs_epu8(__UTF8_PREV(input, previous, 3), _mm_set1_epi8((char)(0xF0 - 0x80)));
+  __m128i expected = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+  return _mm_xor_si128(expected, special);
+}
+#  endif
+
+static bool utf8Validate(const u8 *data, size_t length) {
+#  if defined(BASE_AVX2)
+  // NOTE: A lead byte in the last 3 positions still needs bytes from the next block, which must then check it
+  const __m256i incompleteLimit = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                   -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+  __m256i error = _mm256_setzero_si256();
+  __m256i previous = _mm256_setzero_si256();
+  __m256i incomplete = _mm256_setzero_si256();
+  u8 padded[32];
+  for (size_t i = 0; i < length; i += 32) {
+    __m256i input;
+    if (i + 32 <= length) {
+      input = _mm256_loadu_si256((const __m256i *)(data + i));
+    } else {
+      memset(padded, 0, sizeof(padded)); // NOTE: Zeros are ASCII, they close any sequence cut by the end
+      memcpy(padded, data + i, length - i);
+      input = _mm256_loadu_si256((const __m256i *)padded);
+    }
+    if (_mm256_movemask_epi8(input) == 0) {
+      error = _mm256_or_si256(error, incomplete);
+      incomplete = _mm256_setzero_si256();
+    } else {
+      error = _mm256_or_si256(error, utf8CheckBlock(input, previous));
+      incomplete = _mm256_subs_epu8(input, incompleteLimit);
+    }
+    previous = input;
+  }
+  error = _mm256_or_si256(error, incomplete);
+  return _mm256_testz_si256(error, error);
+#  elif defined(BASE_SSSE3)
+  // NOTE: ASCII is tested per 64 bytes, per 16 the branch goes either way on mixed text and costs more than it saves
+  const __m128i incompleteLimit = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+  __m128i error = _mm_setzero_si128();
+  __m128i previous = _mm_setzero_si128();
+  __m128i incomplete = _mm_setzero_si128();
+  u8 padded[64];
+  for (size_t i = 0; i < length; i += 64) {
+    const u8 *chunk = data + i;
+    if (i + 64 > length) {
+      memset(padded, 0, sizeof(padded)); // NOTE: Zeros are ASCII, they close any sequence cut by the end
+      memcpy(padded, data + i, length - i);
+      chunk = padded;
+    }
+    __m128i input[4];
+    for (u32 k = 0; k < 4; k++) {
+      input[k] = _mm_loadu_si128((const __m128i *)(chunk + k * 16));
+    }
+    __m128i any = _mm_or_si128(_mm_or_si128(input[0], input[1]), _mm_or_si128(input[2], input[3]));
+    if (_mm_movemask_epi8(any) == 0) {
+      error = _mm_or_si128(error, incomplete);
+      incomplete = _mm_setzero_si128();
+      previous = input[3];
+      continue;
+    }
+    for (u32 k = 0; k < 4; k++) {
+      error = _mm_or_si128(error, utf8CheckBlock16(input[k], previous));
+      previous = input[k];
+    }
+    incomplete = _mm_subs_epu8(input[3], incompleteLimit);
+  }
+  error = _mm_or_si128(error, incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+#  else
+  size_t i = 0;
+  while (i < length) {
+    if (data[i] < 0x80) {
+#    if defined(BASE_SSE2)
+      if (i + 16 <= length) {
+        u32 mask = (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + i)));
+        i += mask ? __BitCtz64(mask) : 16;
+        continue;
+      }
+#    endif
+      i++;
+      continue;
+    }
+    u32 codepoint;
+    u32 size = utf8Decode(data + i, length - i, &codepoint);
+    if (size == 0) {
+      return false;
+    }
+    i += size;
+  }
+  return true;
+#  endif
+}
+
+bool StrIsValidUtf8(String *str) {
+  return utf8Validate((const u8 *)str->data, str->length);
+}
+
+size_t StrUtf8Length(String *str) {
+  const i8 *data = (const i8 *)str->data;
+  size_t count = 0;
+  size_t i = 0;
+  // NOTE: Continuation bytes are 0x80-0xBF, as signed bytes they are the only ones at or below -65
+#  if defined(BASE_AVX2)
+  __m256i limit32 = _mm256_set1_epi8(-65);
+  for (; i + 32 <= str->length; i += 32) {
+    __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+    count += __BitPopCount64((u32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, limit32)));
+  }
+#  endif
+#  if defined(BASE_SSE2)
+  __m128i limit16 = _mm_set1_epi8(-65);
+  for (; i + 16 <= str->length; i += 16) {
+    __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+    count += __BitPopCount64((u32)_mm_movemask_epi8(_mm_cmpgt_epi8(block, limit16)));
+  }
+#  endif
+  for (; i < str->length; i++) {
+    count += data[i] > -65;
+  }
+  return count;
+}
+
+StrUtf8Iter StrUtf8IterNew(String *str) {
+  return (StrUtf8Iter){.source = *str};
+}
+
+bool StrUtf8Next(StrUtf8Iter *it) {
+  it->offset += it->size;
+  if (it->offset >= it->source.length) {
+    it->size = 0;
+    return false;
+  }
+  it->size = utf8Decode((const u8 *)it->source.data + it->offset, it->source.length - it->offset, &it->codepoint);
+  if (it->size == 0) {
+    it->codepoint = 0xFFFD;
+    it->size = 1;
+  }
+  return true;
+}
+
+errno_t StrToUtf32(Arena *arena, String *str, StrUtf32 *result) {
+  const u8 *data = (const u8 *)str->data;
+  size_t length = str->length;
+  u32 *out = (u32 *)ArenaAlloc(arena, Max(StrUtf8Length(str), 1) * sizeof(u32)); // NOTE: Enough even for invalid text
+  size_t count = 0;
+  size_t i = 0;
+  while (i < length) {
+#  if defined(BASE_SSE2)
+    if (i + 16 <= length) {
+      __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+      if (_mm_movemask_epi8(block) == 0) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i low = _mm_unpacklo_epi8(block, zero);
+        __m128i high = _mm_unpackhi_epi8(block, zero);
+        _mm_storeu_si128((__m128i *)(out + count), _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128((__m128i *)(out + count + 4), _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128((__m128i *)(out + count + 8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128((__m128i *)(out + count + 12), _mm_unpackhi_epi16(high, zero));
+        count += 16;
+        i += 16;
+        continue;
+      }
+    }
+#  endif
+    u32 size = utf8Decode(data + i, length - i, &out[count]);
+    if (size == 0) {
+      *result = (StrUtf32){0};
+      return STR_UTF8_INVALID;
+    }
+    count++;
+    i += size;
+  }
+  *result = (StrUtf32){.data = out, .length = count};
+  return SUCCESS;
+}
+
+errno_t StrFromUtf32(Arena *arena, StrUtf32 *str, String *result) {
+  size_t length = 0;
+  for (size_t i = 0; i < str->length; i++) {
+    u32 size = utf8EncodedSize(str->data[i]);
+    if (size == 0) {
+      *result = (String){0};
+      return STR_UTF8_INVALID;
+    }
+    length += size;
+  }
+
+  u8 *out = (u8 *)ArenaAllocChars(arena, length + 1);
+  size_t written = 0;
+  for (size_t i = 0; i < str->length; i++) {
+    written += utf8Encode(str->data[i], out + written);
+  }
+  out[length] = '\0';
+  *result = (String){.length = length, .data = (char *)out};
+  return SUCCESS;
+}
+
+/* Hashing Implementation */
+static const u64 hashSecret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+// 64x64 -> 128 bit multiply, `a` gets the low half and `b` the high half
+static inline void hashMultiply(u64 *a, u64 *b) {
+#  if defined(COMPILER_MSVC)
+  u64 high;
+  *a = _umul128(*a, *b, &high);
+  *b = high;
+#  else
+  __uint128_t result = (__uint128_t)*a * *b;
+  *a = (u64)result;
+  *b = (u64)(result >> 64);
+#  endif
+}
+
+static inline u64 hashMix(u64 a, u64 b) {
+  hashMultiply(&a, &b);
+  return a ^ b;
+}
+
+static inline u64 hashRead8(const u8 *p) {
+  u64 value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline u64 hashRead4(const u8 *p) {
+  u32 value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline u64 hashSeed(u64 seed) {
+  return seed ^ hashMix(seed ^ hashSecret[0], hashSecret[1]);
+}
+
+// Reads inputs of 16 bytes or less, possibly overlapping
+static inline void hashShort(const u8 *p, size_t length, u64 *a, u64 *b) {
+  if (length >= 4) {
+    size_t mid = (length >> 3) << 2;
+    *a = (hashRead4(p) << 32) | hashRead4(p + mid);
+    *b = (hashRead4(p + length - 4) << 32) | hashRead4(p + length - 4 - mid);
+  } else if (length > 0) {
+    *a = ((u64)p[0] << 16) | ((u64)p[length >> 1] << 8) | p[length - 1];
+    *b = 0;
+  } else {
+    *a = *b = 0;
+  }
+}
+
+static inline void hashBlock(const u8 *p, u64 *seed, u64 *see1, u64 *see2) {
+  *seed = hashMix(hashRead8(p) ^ hashSecret[1], hashRead8(p + 8) ^ *seed);
+  *see1 = hashMix(hashRead8(p + 16) ^ hashSecret[2], hashRead8(p + 24) ^ *see1);
+  *see2 = hashMix(hashRead8(p + 32) ^ hashSecret[3], hashRead8(p + 40) ^ *see2);
+}
+
+// Consumes the last 1-48 bytes, `p + length - 16` may reach back into already hashed data
+static inline void hashTail(const u8 *p, size_t length, u64 *seed, u64 *a, u64 *b) {
+  while (length > 16) {
+    *seed = hashMix(hashRead8(p) ^ hashSecret[1], hashRead8(p + 8) ^ *seed);
+    length -= 16;
+    p += 16;
+  }
+  *a = hashRead8(p + length - 16);
+  *b = hashRead8(p + length - 8);
+}
+
+static inline Hash128 hashFinish(u64 a, u64 b, u64 seed, u64 length) {
+  a ^= hashSecret[1];
+  b ^= seed;
+  hashMultiply(&a, &b);
+  return (Hash128){
+      .low = hashMix(a ^ hashSecret[0] ^ length, b ^ hashSecret[1]),
+      .high = hashMix(a ^ hashSecret[2], b ^ hashSecret[3] ^ length),
+  };
+}
+
+static Hash128 hashBytes(const void *data, size_t length, u64 seed) {
+  const u8 *p = (const u8 *)data;
+  u64 a, b;
+  seed = hashSeed(seed);
+  if (length <= 16) {
+    hashShort(p, length, &a, &b);
+  } else {
+    size_t i = length;
+    if (_BASE_UNLIKELY(i > 48)) {
+      u64 see1 = seed, see2 = seed;
+      do {
+        hashBlock(p, &seed, &see1, &see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    hashTail(p, i, &seed, &a, &b);
+  }
+  return hashFinish(a, b, seed, length);
+}
+
+u64 HashBytes(const void *data, size_t length, u64 seed) {
+  return hashBytes(data, length, seed).low;
+}
+
+Hash128 HashBytes128(const void *data, size_t length, u64 seed) {
+  return hashBytes(data, length, seed);
+}
+
+u64 StrHash(String *str) {
+  return hashBytes(str->data, str->length, 0).low;
+}
+
+u64 StrHashNoCase(String *str) {
+  char folded[256];
+  if (str->length <= sizeof(folded)) {
+    memcpy(folded, str->data, str->length);
+    strCaseFlip(folded, str->length, 'A');
+    return hashBytes(folded, str->length, 0).low;
+  }
+
+  HashState state;
+  HashInit(&state, 0);
+  for (size_t i = 0; i < str->length; i += sizeof(folded)) {
+    size_t take = Min(sizeof(folded), str->length - i);
+    memcpy(folded, str->data + i, take);
+    strCaseFlip(folded, take, 'A');
+    HashUpdate(&state, folded, take);
+  }
+  return HashFinal(&state);
+}
+
+void HashInit(HashState *state, u64 seed) {
+  memset(state, 0, sizeof(*state));
+  state->seed = state->see1 = state->see2 = hashSeed(seed);
+}
+
+void HashUpdate(HashState *state, const void *data, size_t length) {
+  const u8 *p = (const u8 *)data;
+  state->length += length;
+  while (length > 0) {
+    // NOTE: A full block is only hashed once more data arrives, the last one goes through `hashTail`
+    if (state->pending == 48) {
+      hashBlock(state->buffer + 16, &state->seed, &state->see1, &state->see2);
+      memcpy(state->buffer, state->buffer + 48, 16);
+      state->pending = 0;
+    }
+
+    if (state->pending == 0 && length > 48) {
+      do {
+        hashBlock(p, &state->seed, &state->see1, &state->see2);
+        p += 48;
+        length -= 48;
+      } while (length > 48);
+      memcpy(state->buffer, p - 16, 16);
+    }
+
+    size_t take = Min(48 - state->pending, length);
+    memcpy(state->buffer + 16 + state->pending, p, take);
+    state->pending += take;
+    p += take;
+    length -= take;
+  }
+}
+
+Hash128 HashFinal128(HashState *state) {
+  u64 a, b;
+  u64 seed = state->seed;
+  if (state->length <= 16) {
+    hashShort(state->buffer + 16, state->pending, &a, &b);
+  } else {
+    if (state->length > 48) {
+      seed ^= state->see1 ^ state->see2;
+    }
+    hashTail(state->buffer + 16, state->pending, &seed, &a, &b);
+  }
+  return hashFinish(a, b, seed, state->length);
+}
+
+u64 HashFinal(HashState *state) {
+  return HashFinal128(state).low;
+}
+
+/* String Parsing Implementation */
+// NOTE: Eight ASCII digits at a time as one little endian word (SWAR)
+static inline bool parseIsEightDigits(u64 word) {
+  return (((word + 0x4646464646464646ULL) | (word - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+}
+
+static inline u64 parseEightDigits(u64 word) {
+  word -= 0x3030303030303030ULL;
+  word = (word * 10) + (word >> 8);
+  return (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+}
+
+// Accumulates digits into `value` until the first non digit, wrapping on more than 19 digits
+static inline const char *parseDigits(const char *cursor, const char *end, u64 *value) {
+  u64 result = *value;
+  while (end - cursor >= 8) {
+    u64 word;
+    memcpy(&word, cursor, sizeof(word));
+    if (!parseIsEightDigits(word)) break;
+    result = result * 100000000 + parseEightDigits(word);
+    cursor += 8;
+  }
+  while (cursor < end && (u8)(*cursor - '0') < 10) {
+    result = result * 10 + (*cursor++ - '0');
+  }
+  *value = result;
+  return cursor;
+}
+
+static errno_t parseUnsigned(const char *cursor, const char *end, u64 *result) {
+  while (cursor < end - 1 && *cursor == '0') cursor++;
+  const char *start = cursor;
+  u64 value = 0;
+  // NOTE: 19 digits always fit, a 20th needs an overflow check
+  const char *stop = parseDigits(cursor, Min(end, cursor + 19), &value);
+  if (stop == start || (stop != end && (u8)(*stop - '0') >= 10)) {
+    return STR_PARSE_INVALID;
+  }
+  if (stop != end) {
+    const char *rest = stop;
+    while (rest < end && (u8)(*rest - '0') < 10) rest++;
+    if (rest != end) {
+      return STR_PARSE_INVALID;
+    }
+    u64 digit = *stop - '0';
+    if (rest - stop > 1 || value > (U64_MAX - digit) / 10) {
+      *result = U64_MAX;
+      return STR_PARSE_OVERFLOW;
+    }
+    value = value * 10 + digit;
+  }
+  *result = value;
+  return SUCCESS;
+}
+
+static inline i32 parseHexDigit(char c) {
+  if ((u8)(c - '0') < 10) return c - '0';
+  if ((u8)((c | 0x20) - 'a') < 6) return (c | 0x20) - 'a' + 10;
+  return -1;
+}
+
+static errno_t parseUnsignedHex(const char *cursor, const char *end, u64 *result) {
+  if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] | 0x20) == 'x') {
+    cursor += 2;
+  }
+  if (cursor == end) {
+    return STR_PARSE_INVALID;
+  }
+
+  u64 value = 0;
+  u32 digits = 0;
+  bool overflow = false;
+  for (; cursor < end; cursor++) {
+    i32 digit = parseHexDigit(*cursor);
+    if (digit < 0) {
+      return STR_PARSE_INVALID;
+    }
+    digits += value != 0 || digit != 0;
+    overflow |= digits > 16;
+    value = (value << 4) | digit;
+  }
+  if (overflow) {
+    *result = U64_MAX;
+    return STR_PARSE_OVERFLOW;
+  }
+  *result = value;
+  return SUCCESS;
+}
+
+static errno_t parseSigned(String *str, i64 *result, bool hex) {
+  const char *cursor = str->data;
+  const char *end = str->data + str->length;
+  bool negative = cursor < end && *cursor == '-';
+  if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+
+  u64 magnitude;
+  errno_t error = hex ? parseUnsignedHex(cursor, end, &magnitude) : parseUnsigned(cursor, end, &magnitude);
+  if (error == STR_PARSE_INVALID) {
+    return error;
+  }
+  u64 limit = negative ? (u64)I64_MAX + 1 : (u64)I64_MAX;
+  if (error == STR_PARSE_OVERFLOW || magnitude > limit) {
+    *result = negative ? I64_MIN : I64_MAX;
+    return STR_PARSE_OVERFLOW;
+  }
+  *result = negative ? (i64)(0 - magnitude) : (i64)magnitude;
+  return SUCCESS;
+}
+
+errno_t StrToI64(String *str, i64 *result) {
+  return parseSigned(str, result, false);
+}
+
+errno_t StrToU64(String *str, u64 *result) {
+  const char *cursor = str->data;
+  if (str->length && *cursor == '+') cursor++;
+  return parseUnsigned(cursor, str->data + str->length, result);
+}
+
+errno_t StrToI64Hex(String *str, i64 *result) {
+  return parseSigned(str, result, true);
+}
+
+errno_t StrToU64Hex(String *str, u64 *result) {
+  const char *cursor = str->data;
+  if (str->length && *cursor == '+') cursor++;
+  return parseUnsignedHex(cursor, str->data + str->length, result);
+}
+
+// 128 bit truncations of 5^q for q in [-342, 341], normalized so the top bit is set, parsing only needs
+// up to 308, the rest is for the cached powers of ten used when printing tiny numbers
+static const u64 strPowersOfFive[684 * 2] = {
+  0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL, 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL,
+  0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL, 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL,
+  0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL, 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL,
+  0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL, 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL,
+  0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL, 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL,
+  0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL, 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL,
+  0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL, 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL,
+  0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL, 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL,
+  0x84A57695FE98746DULL, 0x014BB630F7604B57ULL, 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL,
+  0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL, 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL,
+  0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL, 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL,
+  0xFD00B897478238D0ULL, 0x8920B098955522B4ULL, 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL,
+  0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL, 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL,
+  0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL, 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL,
+  0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL, 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL,
+  0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL, 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL,
+  0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL, 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL,
+  0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL, 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL,
+  0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL, 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL,
+  0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL, 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL,
+  0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL, 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL,
+  0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL, 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL,
+  0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL, 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL,
+  0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL, 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL,
+  0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL, 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL,
+  0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL, 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL,
+  0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL, 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL,
+  0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL, 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL,
+  0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL, 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL,
+  0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL, 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL,
+  0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL, 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL,
+  0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL, 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL,
+  0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL, 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL,
+  0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL, 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL,
+  0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL, 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL,
+  0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL, 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL,
+  0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL, 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL,
+  0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL, 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL,
+  0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL, 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL,
+  0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL, 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL,
+  0xC987434744AC874EULL, 0xA327FFB266B56220ULL, 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL,
+  0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL, 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL,
+  0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL, 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL,
+  0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL, 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL,
+  0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL, 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL,
+  0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL, 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL,
+  0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL, 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL,
+  0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL, 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL,
+  0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL, 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL,
+  0xAECC49914078536DULL, 0x58FAE9F773886E18ULL, 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL,
+  0x888F99797A5E012DULL, 0x6D8406C952429603ULL, 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL,
+  0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL, 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL,
+  0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL, 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL,
+  0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL, 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL,
+  0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL, 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL,
+  0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL, 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL,
+  0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL, 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL,
+  0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL, 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL,
+  0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL, 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL,
+  0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL, 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL,
+  0xB913179899F68584ULL, 0x28E2557B59846E3FULL, 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL,
+  0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL, 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL,
+  0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL, 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL,
+  0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL, 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL,
+  0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL, 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL,
+  0xD77485CB25823AC7ULL, 0x7D633293366B828BULL, 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL,
+  0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL, 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL,
+  0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL, 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL,
+  0xCD795BE870516656ULL, 0x67902E276C921F8BULL, 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL,
+  0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL, 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL,
+  0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL, 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL,
+  0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL, 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL,
+  0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL, 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL,
+  0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL, 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL,
+  0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL, 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL,
+  0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL, 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL,
+  0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL, 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL,
+  0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL, 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL,
+  0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL, 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL,
+  0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL, 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL,
+  0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL, 0xD47487CC8470652BULL, 0x7647C3200069671FULL,
+  0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL, 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL,
+  0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL, 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL,
+  0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL, 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL,
+  0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL, 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL,
+  0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL, 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL,
+  0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL, 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL,
+  0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL, 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL,
+  0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL, 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL,
+  0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL, 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL,
+  0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL, 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL,
+  0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL, 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL,
+  0x8C974F7383725573ULL, 0x1E414218C73A13FBULL, 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL,
+  0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL, 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL,
+  0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL, 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL,
+  0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL, 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL,
+  0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL, 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL,
+  0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL, 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL,
+  0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL, 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL,
+  0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL, 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL,
+  0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL, 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL,
+  0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL, 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL,
+  0xBE89523386091465ULL, 0xF6BBB397F1135823ULL, 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL,
+  0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL, 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL,
+  0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL, 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL,
+  0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL, 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL,
+  0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL, 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL,
+  0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL, 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL,
+  0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL, 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL,
+  0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL, 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL,
+  0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL, 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL,
+  0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL, 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL,
+  0x811CCC668829B887ULL, 0x0806357D5A3F525FULL, 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL,
+  0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL, 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL,
+  0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL, 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL,
+  0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL, 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL,
+  0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL, 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL,
+  0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL, 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL,
+  0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL, 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL,
+  0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL, 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL,
+  0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL, 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL,
+  0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL, 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL,
+  0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL, 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL,
+  0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL, 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL,
+  0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL, 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL,
+  0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL, 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL,
+  0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL, 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL,
+  0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL, 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL,
+  0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL, 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL,
+  0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL, 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL,
+  0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL, 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL,
+  0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL, 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL,
+  0xED246723473E3813ULL, 0x290123E9AAB23B68ULL, 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL,
+  0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL, 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL,
+  0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL, 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL,
+  0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL, 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL,
+  0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL, 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL,
+  0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL, 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL,
+  0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL, 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL,
+  0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL, 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+  0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL, 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+  0xCDB02555653131B6ULL, 0x3792F412CB06794DULL, 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+  0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL, 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+  0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL, 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+  0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL, 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+  0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL, 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+  0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL, 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+  0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL, 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+  0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL, 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+  0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL, 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+  0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL, 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+  0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL, 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+  0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL, 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+  0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL, 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+  0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL, 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+  0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL, 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+  0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL, 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+  0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL, 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+  0xC612062576589DDAULL, 0x95364AFE032A819EULL, 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+  0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL, 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+  0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL, 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+  0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL, 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+  0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL, 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+  0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL, 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+  0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL, 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+  0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL, 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+  0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL, 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+  0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL, 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+  0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL, 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+  0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL, 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+  0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL, 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+  0x8000000000000000ULL, 0x0000000000000000ULL, 0xA000000000000000ULL, 0x0000000000000000ULL,
+  0xC800000000000000ULL, 0x0000000000000000ULL, 0xFA00000000000000ULL, 0x0000000000000000ULL,
+  0x9C40000000000000ULL, 0x0000000000000000ULL, 0xC350000000000000ULL, 0x0000000000000000ULL,
+  0xF424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+  0xBEBC200000000000ULL, 0x0000000000000000ULL, 0xEE6B280000000000ULL, 0x0000000000000000ULL,
+  0x9502F90000000000ULL, 0x0000000000000000ULL, 0xBA43B74000000000ULL, 0x0000000000000000ULL,
+  0xE8D4A51000000000ULL, 0x0000000000000000ULL, 0x9184E72A00000000ULL, 0x0000000000000000ULL,
+  0xB5E620F480000000ULL, 0x0000000000000000ULL, 0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+  0x8E1BC9BF04000000ULL, 0x0000000000000000ULL, 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+  0xDE0B6B3A76400000ULL, 0x0000000000000000ULL, 0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+  0xAD78EBC5AC620000ULL, 0x0000000000000000ULL, 0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+  0x878678326EAC9000ULL, 0x0000000000000000ULL, 0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+  0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL, 0x84595161401484A0ULL, 0x0000000000000000ULL,
+  0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL, 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+  0x813F3978F8940984ULL, 0x4000000000000000ULL, 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+  0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL, 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+  0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL, 0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+  0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL, 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+  0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL, 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+  0x96769950B50D88F4ULL, 0x1314448000000000ULL, 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+  0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL, 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+  0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL, 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+  0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL, 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+  0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL, 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+  0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL, 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+  0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL, 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+  0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL, 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+  0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL, 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+  0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL, 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+  0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL, 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+  0x9F4F2726179A2245ULL, 0x01D762422C946590ULL, 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+  0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL, 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+  0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL, 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL,
+  0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL, 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL,
+  0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL, 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL,
+  0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL, 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL,
+  0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL, 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL,
+  0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL, 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL,
+  0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL, 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL,
+  0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL, 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL,
+  0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL, 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL,
+  0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL, 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL,
+  0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL, 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL,
+  0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL, 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL,
+  0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL, 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL,
+  0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL, 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL,
+  0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL, 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL,
+  0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL, 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL,
+  0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL, 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL,
+  0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL, 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL,
+  0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL, 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL,
+  0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL, 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL,
+  0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL, 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL,
+  0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL, 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL,
+  0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL, 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL,
+  0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL, 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL,
+  0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL, 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL,
+  0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL, 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL,
+  0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL, 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL,
+  0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL, 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL,
+  0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL, 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL,
+  0x9AE757596946075FULL, 0x3375788DE9B06958ULL, 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL,
+  0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL, 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL,
+  0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL, 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL,
+  0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL, 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL,
+  0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL, 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL,
+  0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL, 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL,
+  0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL, 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL,
+  0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL, 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL,
+  0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL, 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL,
+  0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL, 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL,
+  0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL, 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL,
+  0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL, 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL,
+  0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL, 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL,
+  0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL, 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL,
+  0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL, 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL,
+  0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL, 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL,
+  0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL, 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL,
+  0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL, 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL,
+  0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL, 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL,
+  0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL, 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL,
+  0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL, 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL,
+  0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL, 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL,
+  0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL, 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL,
+  0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL, 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL,
+  0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL, 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL,
+  0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL, 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL,
+  0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL, 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL,
+  0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL, 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL,
+  0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL, 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL,
+  0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL, 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL,
+  0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL, 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL,
+  0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL, 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL,
+  0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL, 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL,
+  0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL, 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL,
+  0x8FA475791A569D10ULL, 0xF96E017D694487BCULL, 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL,
+  0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL, 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL,
+  0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL, 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL,
+  0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL, 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL,
+  0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL, 0x85C7056562757456ULL, 0xF6872D5667844E49ULL,
+  0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL, 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL,
+  0x82A45B450226B39CULL, 0xECC0024661173473ULL, 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL,
+  0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL, 0xFF290242C83396CEULL, 0x7E67047175A15271ULL,
+  0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL, 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL,
+  0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL, 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL,
+  0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL, 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL,
+  0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL, 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL,
+  0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL, 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL,
+  0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL, 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL,
+  0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL, 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL,
+  0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL, 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL,
+  0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL, 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL,
+  0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL, 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL,
+  0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL, 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL,
+  0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL, 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL,
+  0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL, 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL,
+  0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL, 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL,
+  0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL, 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL,
+  0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL, 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL,
+  0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL, 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL,
+  0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL, 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL,
+  0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL, 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL,
+  0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL, 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL,
+  0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL, 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL,
+  0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL, 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL,
+  0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL, 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL,
+  0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL, 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL,
+  0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL, 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL,
+  0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL, 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL,
+  0x8533285C936B35DEULL, 0xD53A88958F87275FULL, 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL,
+  0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL, 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL,
+  0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL, 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL,
+  0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL, 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL,
+  0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL, 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL,
+  0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL, 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL,
+  0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL, 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL,
+  0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL, 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL,
+  0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL, 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL,
+  0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL, 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL,
+  0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL, 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL,
+  0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL, 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL,
+  0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL, 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL,
+  0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL, 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL,
+  0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL, 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL,
+  0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL, 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL,
+  0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL, 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL,
+  0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL, 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL,
+  0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL, 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL,
+  0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL, 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL,
+  0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL, 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL,
+  0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL, 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL,
+  0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL, 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL,
+  0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL, 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL,
+  0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL, 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL,
+  0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL, 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL,
+  0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL, 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL,
+  0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL, 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL,
+  0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL, 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL,
+  0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL, 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL,
+  0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL, 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL,
+  0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL, 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL,
+  0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL, 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL,
+  0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL, 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL,
+  0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL, 0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL,
+  0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL, 0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL,
+  0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL, 0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL,
+  0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL, 0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL,
+  0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL, 0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL,
+  0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL, 0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL,
+  0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL, 0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL,
+  0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL, 0xDB68C2CA82ED2A05ULL, 0xA67398DB9F6820E1ULL
+};
+
+// Eisel-Lemire, `w * 10^q` correctly rounded from the 128 bit product with the truncated power of five,
+// which is always precise enough for 64 bit mantissas (Mushtak and Lemire), returns the double bits
+static u64 parseEiselLemire(u64 w, i64 q) {
+  if (w == 0 || q < -342) {
+    return 0;
+  }
+  if (q > 308) {
+    return 0x7FFULL << 52;
+  }
+
+  u32 leadingZeros = __BitClz64(w);
+  w <<= leadingZeros;
+
+  const u64 *power = &strPowersOfFive[2 * (q + 342)];
+  u64 low = w, high = power[0];
+  hashMultiply(&low, &high);
+  if ((high & 0x1FF) == 0x1FF) {
+    // NOTE: Only the 55 top bits matter, widen the product when they could still be affected by a carry
+    u64 secondLow = w, secondHigh = power[1];
+    hashMultiply(&secondLow, &secondHigh);
+    low += secondHigh;
+    if (secondHigh > low) high++;
+  }
+
+  u32 upperBit = high >> 63;
+  u32 shift = upperBit + 9;
+  u64 mantissa = high >> shift;
+  i64 power2 = ((((152170 + 65536) * (i32)q) >> 16) + 63) + (i64)upperBit - (i64)leadingZeros + 1023;
+  if (power2 <= 0) {
+    // NOTE: Subnormal
+    if (-power2 + 1 >= 64) {
+      return 0;
+    }
+    mantissa >>= -power2 + 1;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    power2 = mantissa < (1ULL << 52) ? 0 : 1;
+    return mantissa | ((u64)power2 << 52);
+  }
+
+  // NOTE: Exactly halfway between two doubles, round to even instead of up
+  if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high) {
+    mantissa &= ~1ULL;
+  }
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >= (2ULL << 52)) {
+    mantissa = 1ULL << 52;
+    power2++;
+  }
+  mantissa &= ~(1ULL << 52);
+  if (power2 >= 0x7FF) {
+    return 0x7FFULL << 52;
+  }
+  return mantissa | ((u64)power2 << 52);
+}
+
+// Arbitrary precision unsigned integer for the decimals Eisel-Lemire can't settle, 768 digits are enough to decide
+// any rounding and together with the powers of five and two a comparison needs they fit in 160 limbs
+#  define __PARSE_BIG_LIMBS 160
+#  define __PARSE_MAX_DIGITS 768
+
+typedef struct {
+  u32 limbs[__PARSE_BIG_LIMBS];
+  u32 length;
+} __ParseBig;
+
+static void parseBigMulAdd(__ParseBig *big, u32 multiplier, u32 addend) {
+  u64 carry = addend;
+  for (u32 i = 0; i < big->length; i++) {
+    u64 product = (u64)big->limbs[i] * multiplier + carry;
+    big->limbs[i] = (u32)product;
+    carry = product >> 32;
+  }
+  if (carry) {
+    assert(big->length < __PARSE_BIG_LIMBS && "StrToF64: big integer overflow");
+    big->limbs[big->length++] = (u32)carry;
+  }
+}
+
+static void parseBigMulPow5(__ParseBig *big, u32 exponent) {
+  static const u32 powers[13] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625};
+  for (; exponent >= 13; exponent -= 13) {
+    parseBigMulAdd(big, 1220703125, 0);
+  }
+  parseBigMulAdd(big, powers[exponent], 0);
+}
+
+static void parseBigShiftLeft(__ParseBig *big, u32 bits) {
+  u32 words = bits / 32;
+  u32 rest = bits % 32;
+  u32 length = big->length;
+  if (rest) {
+    u32 carry = 0;
+    for (u32 i = 0; i < length; i++) {
+      u32 limb = big->limbs[i];
+      big->limbs[i] = (limb << rest) | carry;
+      carry = limb >> (32 - rest);
+    }
+    if (carry) big->limbs[length++] = carry;
+  }
+  assert(length + words <= __PARSE_BIG_LIMBS && "StrToF64: big integer overflow");
+  memmove(big->limbs + words, big->limbs, length * sizeof(u32));
+  memset(big->limbs, 0, words * sizeof(u32));
+  big->length = length + words;
+}
+
+static i32 parseBigCompare(__ParseBig *a, __ParseBig *b) {
+  if (a->length != b->length) {
+    return a->length > b->length ? 1 : -1;
+  }
+  for (u32 i = a->length; i-- > 0;) {
+    if (a->limbs[i] != b->limbs[i]) return a->limbs[i] > b->limbs[i] ? 1 : -1;
+  }
+  return 0;
+}
+
+// Picks `bits` or the next double up by comparing the exact decimal with the halfway point between them, for
+// when the digits past the 19th decide the rounding. No libc, so the result doesn't depend on the locale
+static u64 parseSlowPath(const char *digits, const char *digitsEnd, i64 explicitExponent, u64 bits) {
+  static const u32 powersOfTen[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  __ParseBig decimal = {0};
+  i64 exponent = explicitExponent; // NOTE: The decimal is `decimal * 10^exponent`
+  u32 kept = 0;
+  u32 chunk = 0;
+  u32 chunkDigits = 0;
+  bool fraction = false;
+  bool tail = false; // NOTE: Non zero digits past the ones kept
+  for (const char *cursor = digits; cursor < digitsEnd; cursor++) {
+    if (*cursor == '.') {
+      fraction = true;
+      continue;
+    }
+    u32 digit = *cursor - '0';
+    if (kept == 0 && digit == 0) {
+      exponent -= fraction;
+      continue;
+    }
+    if (kept == __PARSE_MAX_DIGITS) {
+      tail |= digit != 0;
+      exponent += !fraction;
+      continue;
+    }
+    chunk = chunk * 10 + digit;
+    kept++;
+    exponent -= fraction;
+    if (++chunkDigits == 9) {
+      parseBigMulAdd(&decimal, powersOfTen[9], chunk);
+      chunk = chunkDigits = 0;
+    }
+  }
+  if (chunkDigits) {
+    parseBigMulAdd(&decimal, powersOfTen[chunkDigits], chunk);
+  }
+
+  // NOTE: `bits` is `mantissa * 2^binaryExponent`, the halfway point up is `(2 * mantissa + 1) * 2^(binaryExponent - 1)`
+  u64 mantissa = bits & ((1ULL << 52) - 1);
+  i64 binaryExponent = -1074;
+  if (bits >> 52) {
+    mantissa |= 1ULL << 52;
+    binaryExponent = (i64)(bits >> 52) - 1075;
+  }
+  u64 twice = 2 * mantissa + 1;
+  __ParseBig halfway = {.limbs = {(u32)twice, (u32)(twice >> 32)}, .length = twice >> 32 ? 2 : 1};
+
+  if (exponent >= 0) {
+    parseBigMulPow5(&decimal, exponent);
+  } else {
+    parseBigMulPow5(&halfway, -exponent);
+  }
+  i64 shift = exponent - (binaryExponent - 1); // NOTE: What's left are powers of two
+  if (shift > 0) {
+    parseBigShiftLeft(&decimal, shift);
+  } else {
+    parseBigShiftLeft(&halfway, -shift);
+  }
+
+  i32 order = parseBigCompare(&decimal, &halfway);
+  if (order == 0 && tail) {
+    order = 1;
+  }
+  return order > 0 || (order == 0 && (mantissa & 1)) ? bits + 1 : bits;
+}
+
+static bool parseMatchNoCase(const char *cursor, const char *end, const char *word) {
+  size_t length = strlen(word);
+  if ((size_t)(end - cursor) != length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if ((cursor[i] | 0x20) != word[i]) return false;
+  }
+  return true;
+}
+
+errno_t StrToF64(String *str, f64 *result) {
+  static const f64 exactPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const char *cursor = str->data;
+  const char *end = str->data + str->length;
+  bool negative = cursor < end && *cursor == '-';
+  if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+
+  if (cursor < end && ((*cursor | 0x20) == 'i' || (*cursor | 0x20) == 'n')) {
+    if (parseMatchNoCase(cursor, end, "inf") || parseMatchNoCase(cursor, end, "infinity")) {
+      *result = negative ? -(f64)INFINITY : (f64)INFINITY;
+      return SUCCESS;
+    }
+    if (parseMatchNoCase(cursor, end, "nan")) {
+      *result = negative ? -(f64)NAN : (f64)NAN;
+      return SUCCESS;
+    }
+    return STR_PARSE_INVALID;
+  }
+
+  const char *digitsStart = cursor;
+  u64 w = 0;
+  cursor = parseDigits(cursor, end, &w);
+  const char *integerEnd = cursor;
+  i64 digitCount = integerEnd - digitsStart;
+  i64 exponent = 0;
+  const char *fractionStart = NULL;
+  if (cursor < end && *cursor == '.') {
+    fractionStart = ++cursor;
+    cursor = parseDigits(cursor, end, &w);
+    exponent = fractionStart - cursor;
+    digitCount -= exponent;
+  }
+  if (digitCount == 0) {
+    return STR_PARSE_INVALID;
+  }
+  const char *digitsEnd = cursor;
+
+  i64 explicitExponent = 0;
+  if (cursor < end && (*cursor | 0x20) == 'e') {
+    cursor++;
+    bool negativeExponent = cursor < end && *cursor == '-';
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+    if (cursor == end || (u8)(*cursor - '0') >= 10) {
+      return STR_PARSE_INVALID;
+    }
+    for (; cursor < end && (u8)(*cursor - '0') < 10; cursor++) {
+      if (explicitExponent < 0x10000000) explicitExponent = explicitExponent * 10 + (*cursor - '0');
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    explicitExponent = negativeExponent ? -explicitExponent : explicitExponent;
+  }
+  if (cursor != end) {
+    return STR_PARSE_INVALID;
+  }
+
+  // NOTE: More than 19 significant digits don't fit, keep the first 19 and remember the rest was cut
+  bool truncated = false;
+  if (digitCount > 19) {
+    const char *leading = digitsStart;
+    while (leading < cursor && (*leading == '0' || *leading == '.')) {
+      if (*leading == '0') digitCount--;
+      leading++;
+    }
+    if (digitCount > 19) {
+      truncated = true;
+      w = 0;
+      const char *digit = digitsStart;
+      while (w < 1000000000000000000ULL && digit < integerEnd) w = w * 10 + (*digit++ - '0');
+      if (w >= 1000000000000000000ULL) {
+        exponent = (integerEnd - digit) + explicitExponent;
+      } else {
+        digit = fractionStart;
+        while (w < 1000000000000000000ULL && digit < end && (u8)(*digit - '0') < 10) w = w * 10 + (*digit++ - '0');
+        exponent = (fractionStart - digit) + explicitExponent;
+      }
+    }
+  }
+
+  f64 value;
+  if (!truncated && exponent >= -22 && exponent <= 22 && w <= (1ULL << 53)) {
+    // NOTE: Clinger's fast path, both operands are exact so one rounding gives the right answer
+    value = exponent < 0 ? (f64)w / exactPowers[-exponent] : (f64)w * exactPowers[exponent];
+  } else {
+    u64 bits = parseEiselLemire(w, exponent);
+    if (truncated && bits != parseEiselLemire(w + 1, exponent)) {
+      bits = parseSlowPath(digitsStart, digitsEnd, explicitExponent, bits); // NOTE: The cut digits decide the rounding
+    }
+    memcpy(&value, &bits, sizeof(value));
+  }
+
+  *result = negative ? -value : value;
+  if (value == (f64)INFINITY) {
+    return STR_PARSE_OVERFLOW;
+  }
+  return SUCCESS;
+}
+
+/* Number Formatting Implementation */
+static const char strDigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                    "8081828384858687888990919293949596979899";
+
+static u32 strDigitCount(u64 value) {
+  u32 count = 1;
+  for (;;) {
+    if (value < 10) return count;
+    if (value < 100) return count + 1;
+    if (value < 1000) return count + 2;
+    if (value < 10000) return count + 3;
+    value /= 10000;
+    count += 4;
+  }
+}
+
+size_t StrWriteU64(char *buffer, u64 value) {
+  u32 length = strDigitCount(value);
+  char *cursor = buffer + length;
+  while (value >= 100) {
+    u32 pair = (u32)(value % 100) * 2;
+    value /= 100;
+    *--cursor = strDigitPairs[pair + 1];
+    *--cursor = strDigitPairs[pair];
+  }
+  if (value >= 10) {
+    *--cursor = strDigitPairs[value * 2 + 1];
+    *--cursor = strDigitPairs[value * 2];
+  } else {
+    *--cursor = (char)('0' + value);
+  }
+  return length;
+}
+
+size_t StrWriteI64(char *buffer, i64 value) {
+  if (value < 0) {
+    *buffer = '-';
+    return StrWriteU64(buffer + 1, 0 - (u64)value) + 1;
+  }
+  return StrWriteU64(buffer, value);
+}
+
+// Grisu3 (Loitsch), `f * 2^e` with the rounded 64 bit products of the paper
+typedef struct {
+  u64 f;
+  i32 e;
+} __DiyFp;
+
+static __DiyFp grisuMultiply(__DiyFp x, __DiyFp y) {
+  u64 low = x.f, high = y.f;
+  hashMultiply(&low, &high);
+  high += low >> 63; // NOTE: Round the dropped half
+  return (__DiyFp){high, x.e + y.e + 64};
+}
+
+static __DiyFp grisuNormalize(__DiyFp value) {
+  u32 shift = __BitClz64(value.f);
+  return (__DiyFp){value.f << shift, value.e - (i32)shift};
+}
+
+// 10^k rounded to 64 bits, taken from the top of the 128 bit powers of five used by the parser
+static __DiyFp grisuPowerOfTen(i32 k) {
+  const u64 *power = &strPowersOfFive[2 * (k + 342)];
+  __DiyFp result = {power[0], ((k * 217706) >> 16) - 63};
+  if (power[1] >> 63) {
+    result.f++;
+    if (result.f == 0) {
+      result.f = 1ULL << 63;
+      result.e++;
+    }
+  }
+  return result;
+}
+
+static bool grisuRoundWeed(char *buffer, i32 length, u64 distance, u64 delta, u64 rest, u64 tenKappa, u64 unit) {
+  u64 distanceUp = distance - unit;
+  u64 distanceDown = distance + unit;
+  while (rest < distanceUp && delta - rest >= tenKappa && (rest + tenKappa < distanceUp || distanceUp - rest >= rest + tenKappa - distanceUp)) {
+    buffer[length - 1]--;
+    rest += tenKappa;
+  }
+  if (rest < distanceDown && delta - rest >= tenKappa && (rest + tenKappa < distanceDown || distanceDown - rest > rest + tenKappa - distanceDown)) {
+    return false;
+  }
+  return 2 * unit <= rest && rest <= delta - 4 * unit;
+}
+
+// Digits of `high` until they land inside the unsafe interval, false when Grisu can't prove them shortest
+static bool grisuDigits(__DiyFp low, __DiyFp w, __DiyFp high, char *buffer, i32 *length, i32 *kappa) {
+  static const u32 powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  u64 unit = 1;
+  u64 tooLow = low.f - unit;
+  u64 tooHigh = high.f + unit;
+  u64 unsafe = tooHigh - tooLow;
+  u32 shift = -w.e;
+  u64 one = 1ULL << shift;
+  u32 integral = (u32)(tooHigh >> shift);
+  u64 fractional = tooHigh & (one - 1);
+
+  *kappa = strDigitCount(integral);
+  *length = 0;
+  while (*kappa > 0) {
+    u32 divisor = powers[*kappa - 1];
+    buffer[(*length)++] = (char)('0' + integral / divisor);
+    integral %= divisor;
+    (*kappa)--;
+    u64 rest = ((u64)integral << shift) + fractional;
+    if (rest < unsafe) {
+      return grisuRoundWeed(buffer, *length, tooHigh - w.f, unsafe, rest, (u64)divisor << shift, unit);
+    }
+  }
+
+  for (;;) {
+    fractional *= 10;
+    unit *= 10;
+    unsafe *= 10;
+    buffer[(*length)++] = (char)('0' + (fractional >> shift));
+    fractional &= one - 1;
+    (*kappa)--;
+    if (fractional < unsafe) {
+      return grisuRoundWeed(buffer, *length, (tooHigh - w.f) * unit, unsafe, fractional, one, unit);
+    }
+  }
+}
+
+static bool grisu3(f64 value, char *digits, i32 *length, i32 *exponent) {
+  u64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  u64 mantissa = bits & ((1ULL << 52) - 1);
+  u32 biased = (bits >> 52) & 0x7FF;
+  __DiyFp v = biased ? (__DiyFp){mantissa | (1ULL << 52), (i32)biased - 1075} : (__DiyFp){mantissa, -1074};
+
+  // NOTE: Boundaries halfway to the neighbours, the lower one is closer at powers of two
+  __DiyFp high = grisuNormalize((__DiyFp){(v.f << 1) + 1, v.e - 1});
+  __DiyFp low = (mantissa == 0 && biased > 1) ? (__DiyFp){(v.f << 2) - 1, v.e - 2} : (__DiyFp){(v.f << 1) - 1, v.e - 1};
+  low.f <<= low.e - high.e;
+  low.e = high.e;
+  __DiyFp w = grisuNormalize(v);
+
+  // NOTE: Scale by 10^k so the products have their binary exponent in [-60, -32]
+  i32 target = -60 - 64 - w.e + 63;
+  i32 k = ((target * 78913) >> 18) + (target != 0); // NOTE: Ceil, `target * log10(2)` is never an integer
+  __DiyFp power = grisuPowerOfTen(k);
+  i32 kappa;
+  bool success = grisuDigits(grisuMultiply(low, power), grisuMultiply(w, power), grisuMultiply(high, power), digits, length, &kappa);
+  *exponent = kappa - k;
+  return success;
+}
+
+// Exact but slow, the shortest `%.*e` output that parses back, for the few values Grisu3 rejects. A correctly
+// rounded output that round trips keeps doing so with more digits, so the precision can be binary searched
+static void strShortestFallback(f64 value, char *digits, i32 *length, i32 *exponent) {
+  char buffer[40];
+  i32 lowest = 1, highest = 17;
+  while (lowest < highest) {
+    i32 precision = (lowest + highest) / 2;
+    i32 written = snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, value);
+    f64 parsed;
+    if (StrToF64(&(String){.length = (size_t)written, .data = buffer}, &parsed) == SUCCESS && parsed == value) {
+      highest = precision;
+    } else {
+      lowest = precision + 1;
+    }
+  }
+  snprintf(buffer, sizeof(buffer), "%.*e", lowest - 1, value);
+
+  *length = 0;
+  char *cursor = buffer;
+  for (; *cursor != 'e'; cursor++) {
+    if (*cursor != '.') digits[(*length)++] = *cursor;
+  }
+  i64 decimalExponent = 0;
+  StrToI64(&(String){.length = strlen(cursor + 1), .data = cursor + 1}, &decimalExponent);
+  while (*length > 1 && digits[*length - 1] == '0') (*length)--;
+  *exponent = (i32)decimalExponent - (*length - 1);
+}
+
+size_t StrWriteF64(char *buffer, f64 value) {
+  char *cursor = buffer;
+  u64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (bits >> 63) {
+    *cursor++ = '-';
+    value = -value;
+  }
+  if (value != value) {
+    memcpy(buffer, "nan", 3);
+    return 3;
+  }
+  if (value == (f64)INFINITY) {
+    memcpy(cursor, "inf", 3);
+    return cursor - buffer + 3;
+  }
+  if (value == 0) {
+    *cursor = '0';
+    return cursor - buffer + 1;
+  }
+
+  char digits[24];
+  i32 length, exponent;
+  if (!grisu3(value, digits, &length, &exponent)) {
+    strShortestFallback(value, digits, &length, &exponent);
+  }
+
+  // NOTE: `point` is where the decimal point goes relative to the first digit
+  i32 point = length + exponent;
+  if (point > 0 && point <= 21) {
+    if (length <= point) {
+      memcpy(cursor, digits, length);
+      memset(cursor + length, '0', point - length);
+      cursor += point;
+    } else {
+      memcpy(cursor, digits, point);
+      cursor[point] = '.';
+      memcpy(cursor + point + 1, digits + point, length - point);
+      cursor += length + 1;
+    }
+  } else if (point <= 0 && point > -6) {
+    memcpy(cursor, "0.", 2);
+    memset(cursor + 2, '0', -point);
+    memcpy(cursor + 2 - point, digits, length);
+    cursor += 2 - point + length;
+  } else {
+    *cursor++ = digits[0];
+    if (length > 1) {
+      *cursor++ = '.';
+      memcpy(cursor, digits + 1, length - 1);
+      cursor += length - 1;
+    }
+    *cursor++ = 'e';
+    *cursor++ = point - 1 < 0 ? '-' : '+';
+    cursor += StrWriteU64(cursor, point - 1 < 0 ? 1 - point : point - 1);
+  }
+  return cursor - buffer;
+}
+
+static String strFromNumber(Arena *arena, char *digits, size_t length) {
+  char *data = ArenaAllocChars(arena, length + 1);
+  memcpy(data, digits, length);
+  return (String){.length = length, .data = data};
+}
+
+String StrFromI64(Arena *arena, i64 value) {
+  char buffer[STR_NUMBER_MAX];
+  return strFromNumber(arena, buffer, StrWriteI64(buffer, value));
+}
+
+String StrFromU64(Arena *arena, u64 value) {
+  char buffer[STR_NUMBER_MAX];
+  return strFromNumber(arena, buffer, StrWriteU64(buffer, value));
+}
+
+String StrFromF64(Arena *arena, f64 value) {
+  char buffer[STR_NUMBER_MAX];
+  return strFromNumber(arena, buffer, StrWriteF64(buffer, value));
+}
+
+/* Hash Map Implementation */
+#  define __MAP_EMPTY 0x80
+#  define __MAP_DELETED 0xFE
+
+static u64 mapHashKey(__MapLayout layout, const void *key) {
+  if (layout.stringKey) {
+    const String *str = (const String *)key;
+    return StrHash((String *)str);
+  }
+  return HashBytes(key, layout.keySize, 0);
+}
+
+static bool mapKeyEqual(__MapLayout layout, const void *key1, const void *key2) {
+  if (layout.stringKey) {
+    return StrEqual((String *)key1, (String *)key2);
+  }
+  return memcmp(key1, key2, layout.keySize) == 0;
+}
+
+// Bitmask of the slots in the group whose control byte equals `byte`
+static u32 mapMatchByte(const u8 *group, u8 byte) {
+#  if defined(BASE_SSE2)
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+#  else
+  u32 mask = 0;
+  for (u32 i = 0; i < MAP_GROUP_WIDTH; i++) {
+    mask |= (u32)(group[i] == byte) << i;
+  }
+  return mask;
+#  endif
+}
+
+// Bitmask of the slots in the group that are empty or deleted
+static u32 mapMatchFree(const u8 *group) {
+#  if defined(BASE_SSE2)
+  return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#  else
+  u32 mask = 0;
+  for (u32 i = 0; i < MAP_GROUP_WIDTH; i++) {
+    mask |= (u32)(group[i] >> 7) << i;
+  }
+  return mask;
+#  endif
+}
+
+static void *mapFindHashed(__Map *map, __MapLayout layout, const void *key, u64 hash) {
+  if (map->capacity == 0) {
+    return NULL;
+  }
+
+  size_t groupMask = map->capacity / MAP_GROUP_WIDTH - 1;
+  size_t group = (hash >> 7) & groupMask;
+  u8 h2 = hash & 0x7F;
+  for (size_t probe = 1;; probe++) {
+    u8 *ctrl = map->ctrl + group * MAP_GROUP_WIDTH;
+    u32 matches = mapMatchByte(ctrl, h2);
+    while (matches) {
+      size_t index = group * MAP_GROUP_WIDTH + __BitCtz64(matches);
+      char *entry = (char *)map->slots + index * layout.entrySize;
+      if (mapKeyEqual(layout, entry, key)) {
+        return entry;
+      }
+      matches &= matches - 1;
+    }
+
+    // NOTE: A group with an empty slot was never full, so the key can't be further along the probe
+    if (mapMatchByte(ctrl, __MAP_EMPTY)) {
+      return NULL;
+    }
+    group = (group + probe) & groupMask; // Triangular probing visits every group
+  }
+}
+
+static size_t mapFindFreeSlot(__Map *map, u64 hash) {
+  size_t groupMask = map->capacity / MAP_GROUP_WIDTH - 1;
+  size_t group = (hash >> 7) & groupMask;
+  for (size_t probe = 1;; probe++) {
+    u32 freeSlots = mapMatchFree(map->ctrl + group * MAP_GROUP_WIDTH);
+    if (freeSlots) {
+      return group * MAP_GROUP_WIDTH + __BitCtz64(freeSlots);
+    }
+    group = (group + probe) & groupMask;
+  }
+}
+
+static void mapResize(__Map *map, __MapLayout layout, size_t capacity) {
+  size_t tableSize = capacity + capacity * layout.entrySize;
+  u8 *table = map->arena ? (u8 *)ArenaAlloc(map->arena, tableSize) : (u8 *)Malloc(tableSize);
+  memset(table, __MAP_EMPTY, capacity);
+
+  __Map old = *map;
+  map->ctrl = table;
+  map->slots = table + capacity;
+  map->capacity = capacity;
+  map->tombstones = 0;
+
+  for (size_t i = 0; i < old.capacity; i++) {
+    if (old.ctrl[i] & 0x80) {
+      continue;
+    }
+    char *entry = (char *)old.slots + i * layout.entrySize;
+    size_t index = mapFindFreeSlot(map, mapHashKey(layout, entry));
+    map->ctrl[index] = old.ctrl[i];
+    memcpy((char *)map->slots + index * layout.entrySize, entry, layout.entrySize);
+  }
+
+  if (!map->arena && old.ctrl) {
+    Free(old.ctrl);
+  }
+}
+
+void *__MapFind(__Map *map, __MapLayout layout, const void *key) {
+  return mapFindHashed(map, layout, key, mapHashKey(layout, key));
+}
+
+static void *mapInsertHashed(__Map *map, __MapLayout layout, const void *key, u64 hash, bool *inserted) {
+  char *entry = (char *)mapFindHashed(map, layout, key, hash);
+  if (entry) {
+    if (inserted) *inserted = false;
+    return entry;
+  }
+
+  // NOTE: Keep at least 1/8 of the slots empty, grow if live entries need it, otherwise just purge tombstones
+  if ((map->length + map->tombstones + 1) * 8 > map->capacity * 7) {
+    if (map->capacity == 0) {
+      mapResize(map, layout, MAP_GROUP_WIDTH);
+    } else if ((map->length + 1) * 16 > map->capacity * 7) {
+      assert(map->capacity <= SIZE_MAX / 2 / (layout.entrySize + 1) && "MapPut: capacity overflow");
+      mapResize(map, layout, map->capacity * 2);
+    } else {
+      mapResize(map, layout, map->capacity);
+    }
+  }
+
+  size_t index = mapFindFreeSlot(map, hash);
+  if (map->ctrl[index] == __MAP_DELETED) {
+    map->tombstones--;
+  }
+  map->ctrl[index] = hash & 0x7F;
+  map->length++;
+
+  entry = (char *)map->slots + index * layout.entrySize;
+  memset(entry, 0, layout.entrySize);
+  memcpy(entry, key, layout.keySize);
+  if (inserted) *inserted = true;
+  return entry;
+}
+
+static bool mapRemoveHashed(__Map *map, __MapLayout layout, const void *key, u64 hash) {
+  char *entry = (char *)mapFindHashed(map, layout, key, hash);
+  if (!entry) {
+    return false;
+  }
+
+  size_t index = (entry - (char *)map->slots) / layout.entrySize;
+  u8 *group = map->ctrl + (index & ~(size_t)(MAP_GROUP_WIDTH - 1));
+  if (mapMatchByte(group, __MAP_EMPTY)) {
+    map->ctrl[index] = __MAP_EMPTY;
+  } else {
+    map->ctrl[index] = __MAP_DELETED;
+    map->tombstones++;
+  }
+  map->length--;
+  return true;
+}
+
+void *__MapInsert(__Map *map, __MapLayout layout, const void *key, bool *inserted) {
+  return mapInsertHashed(map, layout, key, mapHashKey(layout, key), inserted);
+}
+
+bool __MapRemove(__Map *map, __MapLayout layout, const void *key) {
+  return mapRemoveHashed(map, layout, key, mapHashKey(layout, key));
+}
+
+void __MapReserve(__Map *map, __MapLayout layout, size_t count) {
+  size_t capacity = MAP_GROUP_WIDTH;
+  while (count * 8 > capacity * 7) {
+    capacity *= 2;
+  }
+
+  if (capacity > map->capacity) {
+    mapResize(map, layout, capacity);
+  }
+}
+
+void *__MapNext(__Map *map, __MapLayout layout, void *entry) {
+  size_t index = entry ? ((char *)entry - (char *)map->slots) / layout.entrySize + 1 : 0;
+  for (; index < map->capacity; index++) {
+    if (!(map->ctrl[index] & 0x80)) {
+      return (char *)map->slots + index * layout.entrySize;
+    }
+  }
+  return NULL;
+}
+
+void __MapFree(__Map *map) {
+  if (!map->arena && map->ctrl) {
+    Free(map->ctrl);
+  }
+  Arena *arena = map->arena;
+  memset(map, 0, sizeof(*map));
+  map->arena = arena;
+}
+
+/* Concurrent Hash Map Implementation */
+// NOTE: The top bits pick the shard, the map itself uses the low ones so both stay independent
+static __ConcurrentMapShard *concurrentMapShard(__ConcurrentMapShard *shards, u64 hash) {
+  return &shards[hash >> 58];
+}
+
+void __ConcurrentMapInit(__ConcurrentMapShard *shards) {
+  for (size_t i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    memset(&shards[i].map, 0, sizeof(shards[i].map));
+    RwLockInit(&shards[i].lock);
+  }
+}
+
+void __ConcurrentMapFree(__ConcurrentMapShard *shards) {
+  for (size_t i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    __MapFree(&shards[i].map);
+    RwLockDestroy(&shards[i].lock);
+  }
+}
+
+bool __ConcurrentMapGet(__ConcurrentMapShard *shards, __MapLayout layout, void *entry) {
+  u64 hash = mapHashKey(layout, entry);
+  __ConcurrentMapShard *shard = concurrentMapShard(shards, hash);
+  RwLockRead(&shard->lock);
+  void *found = mapFindHashed(&shard->map, layout, entry, hash);
+  if (found) {
+    memcpy(entry, found, layout.entrySize);
+  }
+  RwLockReadUnlock(&shard->lock);
+  return found != NULL;
+}
+
+bool __ConcurrentMapInsert(__ConcurrentMapShard *shards, __MapLayout layout, const void *entry, bool overwrite) {
+  u64 hash = mapHashKey(layout, entry);
+  __ConcurrentMapShard *shard = concurrentMapShard(shards, hash);
+  bool inserted;
+  RwLockWrite(&shard->lock);
+  char *slot = (char *)mapInsertHashed(&shard->map, layout, entry, hash, &inserted);
+  if (inserted || overwrite) {
+    memcpy(slot + layout.valueOffset, (const char *)entry + layout.valueOffset, layout.entrySize - layout.valueOffset);
+  }
+  RwLockWriteUnlock(&shard->lock);
+  return inserted;
+}
+
+void __ConcurrentMapCompute(__ConcurrentMapShard *shards, __MapLayout layout, const void *key, ConcurrentMapComputeFn fn, void *userData) {
+  u64 hash = mapHashKey(layout, key);
+  __ConcurrentMapShard *shard = concurrentMapShard(shards, hash);
+  bool inserted;
+  RwLockWrite(&shard->lock);
+  char *slot = (char *)mapInsertHashed(&shard->map, layout, key, hash, &inserted);
+  fn(slot + layout.valueOffset, !inserted, userData);
+  RwLockWriteUnlock(&shard->lock);
+}
+
+bool __ConcurrentMapRemove(__ConcurrentMapShard *shards, __MapLayout layout, const void *key) {
+  u64 hash = mapHashKey(layout, key);
+  __ConcurrentMapShard *shard = concurrentMapShard(shards, hash);
+  RwLockWrite(&shard->lock);
+  bool removed = mapRemoveHashed(&shard->map, layout, key, hash);
+  RwLockWriteUnlock(&shard->lock);
+  return removed;
+}
+
+size_t __ConcurrentMapLength(__ConcurrentMapShard *shards) {
+  size_t length = 0;
+  for (size_t i = 0; i < CONCURRENT_MAP_SHARDS; i++) {
+    RwLockRead(&shards[i].lock);
+    length += shards[i].map.length;
+    RwLockReadUnlock(&shards[i].lock);
+  }
+  return length;
+}
+
+/* Integer Map and Set Implementation */
+// NOTE: Shared by `IntMap` and `IntSet`, `values` is always NULL for sets
+
+// Fibonacci hashing, keeps the top bits which are the best mixed
+static inline size_t intTableHome(size_t capacity, u64 key) {
+  return (key * 0x9E3779B97F4A7C15ULL) >> __BitClz64(capacity - 1);
+}
+
+static size_t intTableFind(u64 *keys, size_t capacity, u64 key) {
+  assert(key != INT_MAP_EMPTY_KEY && "IntMap: INT_MAP_EMPTY_KEY is reserved");
+  if (capacity == 0) {
+    return SIZE_MAX;
+  }
+
+  size_t mask = capacity - 1;
+  size_t index = intTableHome(capacity, key);
+  for (size_t distance = 0;; distance++) {
+    u64 current = keys[index];
+    if (current == key) {
+      return index;
+    }
+
+    // NOTE: Robin hood invariant, a resident closer to its home means the key would have been placed before it
+    if (current == INT_MAP_EMPTY_KEY || ((index - intTableHome(capacity, current)) & mask) < distance) {
+      return SIZE_MAX;
+    }
+    index = (index + 1) & mask;
+  }
+}
+
+// Places a key known to be missing, returns the slot it ended up in
+static size_t intTablePlace(u64 *keys, u64 *values, size_t capacity, u64 key, u64 value) {
+  size_t mask = capacity - 1;
+  size_t index = intTableHome(capacity, key);
+  size_t placed = SIZE_MAX;
+  for (size_t distance = 0;; distance++) {
+    u64 current = keys[index];
+    if (current == INT_MAP_EMPTY_KEY) {
+      keys[index] = key;
+      if (values) values[index] = value;
+      return placed == SIZE_MAX ? index : placed;
+    }
+
+    size_t currentDistance = (index - intTableHome(capacity, current)) & mask;
+    if (currentDistance < distance) {
+      keys[index] = key;
+      key = current;
+      if (values) Swap(values[index], value);
+      if (placed == SIZE_MAX) placed = index;
+      distance = currentDistance;
+    }
+    index = (index + 1) & mask;
+  }
+}
+
+static void intTableResize(u64 **keys, u64 **values, size_t *capacity, size_t newCapacity) {
+  u64 *newKeys = (u64 *)Malloc(newCapacity * sizeof(u64));
+  memset(newKeys, 0xFF, newCapacity * sizeof(u64)); // NOTE: Every slot starts as `INT_MAP_EMPTY_KEY`
+  u64 *newValues = values ? (u64 *)Malloc(newCapacity * sizeof(u64)) : NULL;
+  for (size_t i = 0; i < *capacity; i++) {
+    if ((*keys)[i] != INT_MAP_EMPTY_KEY) {
+      intTablePlace(newKeys, newValues, newCapacity, (*keys)[i], values ? (*values)[i] : 0);
+    }
+  }
+
+  Free(*keys);
+  *keys = newKeys;
+  if (values) {
+    Free(*values);
+    *values = newValues;
+  }
+  *capacity = newCapacity;
+}
+
+static size_t intTableCapacityFor(size_t count) {
+  size_t capacity = 16;
+  while (count * 8 > capacity * 7) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+static bool intTableRemove(u64 *keys, u64 *values, size_t capacity, u64 key) {
+  size_t index = intTableFind(keys, capacity, key);
+  if (index == SIZE_MAX) {
+    return false;
+  }
+
+  // NOTE: Backward shift deletion, pull the following displaced keys one slot closer to their home
+  size_t mask = capacity - 1;
+  size_t next = (index + 1) & mask;
+  while (keys[next] != INT_MAP_EMPTY_KEY && ((next - intTableHome(capacity, keys[next])) & mask) != 0) {
+    keys[index] = keys[next];
+    if (values) values[index] = values[next];
+    index = next;
+    next = (next + 1) & mask;
+  }
+  keys[index] = INT_MAP_EMPTY_KEY;
+  return true;
+}
+
+u64 *IntMapGet(IntMap *map, u64 key) {
+  size_t index = intTableFind(map->keys, map->capacity, key);
+  return index == SIZE_MAX ? NULL : &map->values[index];
+}
+
+u64 *IntMapPut(IntMap *map, u64 key, u64 value) {
+  size_t index = intTableFind(map->keys, map->capacity, key);
+  if (index != SIZE_MAX) {
+    map->values[index] = value;
+    return &map->values[index];
+  }
+
+  if ((map->length + 1) * 8 > map->capacity * 7) {
+    intTableResize(&map->keys, &map->values, &map->capacity, intTableCapacityFor(map->length + 1));
+  }
+  index = intTablePlace(map->keys, map->values, map->capacity, key, value);
+  map->length++;
+  return &map->values[index];
+}
+
+bool IntMapRemove(IntMap *map, u64 key) {
+  if (!intTableRemove(map->keys, map->values, map->capacity, key)) {
+    return false;
+  }
+  map->length--;
+  return true;
+}
+
+void IntMapReserve(IntMap *map, size_t count) {
+  size_t capacity = intTableCapacityFor(count);
+  if (capacity > map->capacity) {
+    intTableResize(&map->keys, &map->values, &map->capacity, capacity);
+  }
+}
+
+void IntMapGetMany(IntMap *map, const u64 *keys, size_t count, u64 **results) {
+  const size_t distance = 8; // NOTE: How many lookups ahead to prefetch, enough to hide a cache miss
+  for (size_t i = 0; i < count; i++) {
+    if (i + distance < count && map->capacity) {
+      size_t home = intTableHome(map->capacity, keys[i + distance]);
+      _BASE_PREFETCH(&map->keys[home]);
+      _BASE_PREFETCH(&map->values[home]);
+    }
+    results[i] = IntMapGet(map, keys[i]);
+  }
+}
+
+void IntMapFree(IntMap *map) {
+  Free(map->keys);
+  Free(map->values);
+  memset(map, 0, sizeof(*map));
+}
+
+bool IntSetAdd(IntSet *set, u64 key) {
+  if (intTableFind(set->keys, set->capacity, key) != SIZE_MAX) {
+    return false;
+  }
+
+  if ((set->length + 1) * 8 > set->capacity * 7) {
+    intTableResize(&set->keys, NULL, &set->capacity, intTableCapacityFor(set->length + 1));
+  }
+  intTablePlace(set->keys, NULL, set->capacity, key, 0);
+  set->length++;
+  return true;
+}
+
+bool IntSetHas(IntSet *set, u64 key) {
+  return intTableFind(set->keys, set->capacity, key) != SIZE_MAX;
+}
+
+bool IntSetRemove(IntSet *set, u64 key) {
+  if (!intTableRemove(set->keys, NULL, set->capacity, key)) {
+    return false;
+  }
+  set->length--;
+  return true;
+}
+
+void IntSetReserve(IntSet *set, size_t count) {
+  size_t capacity = intTableCapacityFor(count);
+  if (capacity > set->capacity) {
+    intTableResize(&set->keys, NULL, &set->capacity, capacity);
+  }
+}
+
+void IntSetHasMany(IntSet *set, const u64 *keys, size_t count, bool *results) {
+  const size_t distance = 8;
+  for (size_t i = 0; i < count; i++) {
+    if (i + distance < count && set->capacity) {
+      _BASE_PREFETCH(&set->keys[intTableHome(set->capacity, keys[i + distance])]);
+    }
+    results[i] = IntSetHas(set, keys[i]);
+  }
+}
+
+void IntSetFree(IntSet *set) {
+  Free(set->keys);
+  memset(set, 0, sizeof(*set));
+}
+
+/* String Interning Implementation */
+InternTable *InternTableCreate() {
+  InternTable *table = (InternTable *)Malloc(sizeof(InternTable));
+  memset(table, 0, sizeof(*table));
+  table->arena = ArenaCreate(64 * 1024);
+  MapInit(table->ids, table->arena);
+  RwLockInit(&table->lock);
+  return table;
+}
+
+void InternTableFree(InternTable *table) {
+  RwLockDestroy(&table->lock);
+  ArenaFree(table->arena);
+  Free(table);
+}
+
+// Ids are offset by the first page size so the page is just the position of the highest bit
+static u32 internPage(u32 id, size_t *offset) {
+  u64 index = (u64)id + (1 << __INTERN_FIRST_PAGE_BITS);
+  u32 highBit = 63 - __BitClz64(index);
+  *offset = index - ((u64)1 << highBit);
+  return highBit - __INTERN_FIRST_PAGE_BITS;
+}
+
+bool StrInternFind(InternTable *table, String *str, u32 *id) {
+  RwLockRead(&table->lock);
+  u32 *found = MapGet(table->ids, *str);
+  if (found) {
+    *id = *found;
+  }
+  RwLockReadUnlock(&table->lock);
+  return found != NULL;
+}
+
+u32 StrIntern(InternTable *table, String *str) {
+  u32 id;
+  if (StrInternFind(table, str, &id)) {
+    return id;
+  }
+
+  RwLockWrite(&table->lock);
+  u32 *found = MapGet(table->ids, *str); // NOTE: Another thread might have inserted it meanwhile
+  if (found) {
+    id = *found;
+    RwLockWriteUnlock(&table->lock);
+    return id;
+  }
+
+  assert(table->count < U32_MAX && "StrIntern: table is full");
+  id = table->count;
+  size_t offset;
+  u32 page = internPage(id, &offset);
+  if (table->pages[page] == NULL) {
+    table->pages[page] = (String *)ArenaAlloc(table->arena, ((size_t)1 << (page + __INTERN_FIRST_PAGE_BITS)) * sizeof(String));
+  }
+
+  String *slot = &table->pages[page][offset];
+  *slot = StrNewSize(table->arena, str->data, str->length);
+  MapPut(table->ids, *slot, id);
+  table->count++;
+  RwLockWriteUnlock(&table->lock);
+  return id;
+}
+
+String StrInternGet(InternTable *table, u32 id) {
+  size_t offset;
+  u32 page = internPage(id, &offset);
+  assert(table->pages[page] != NULL && "StrInternGet: id was not returned by StrIntern");
+  return table->pages[page][offset];
+}
+
+/* B-Tree Implementation */
+#  define __BTREE_COMPARE_NUMBERS(name, type)                      \
+    i32 __BTreeCompare##name(const void *key1, const void *key2) { \
+      type a = *(const type *)key1;                                \
+      type b = *(const type *)key2;                                \
+      return (a > b) - (a < b);                                    \
+    }
+
+__BTREE_COMPARE_NUMBERS(I64, i64)
+__BTREE_COMPARE_NUMBERS(U64, u64)
+__BTREE_COMPARE_NUMBERS(I32, i32)
+__BTREE_COMPARE_NUMBERS(U32, u32)
+__BTREE_COMPARE_NUMBERS(F64, f64)
+
+i32 __BTreeCompareString(const void *key1, const void *key2) {
+  return StrCompare((String *)key1, (String *)key2);
+}
+
+// Minimum degree `t`, nodes hold between `t - 1` and `2t - 1` keys, aiming for ~256 bytes of keys
+static inline size_t btreeDegree(__BTreeLayout layout) {
+  return Clamp(4, 128 / layout.keySize, 64);
+}
+
+static inline size_t btreeMaxKeys(__BTreeLayout layout) {
+  return 2 * btreeDegree(layout) - 1;
+}
+
+static inline size_t btreeAlign(size_t size) {
+  return (size + 15) & ~(size_t)15;
+}
+
+static inline char *btreeKey(__BTreeLayout layout, __BTreeNode *node, size_t index) {
+  return node->data + index * layout.keySize;
+}
+
+static inline char *btreeValue(__BTreeLayout layout, __BTreeNode *node, size_t index) {
+  return node->data + btreeAlign(btreeMaxKeys(layout) * layout.keySize) + index * layout.valueSize;
+}
+
+// Leaves end right where the children would start
+static inline size_t btreeChildrenOffset(__BTreeLayout layout) {
+  size_t valuesOffset = btreeAlign(btreeMaxKeys(layout) * layout.keySize);
+  return btreeAlign(valuesOffset + btreeMaxKeys(layout) * layout.valueSize);
+}
+
+static inline __BTreeNode **btreeChildren(__BTreeLayout layout, __BTreeNode *node) {
+  return (__BTreeNode **)(node->data + btreeChildrenOffset(layout));
+}
+
+static __BTreeNode *btreeNewNode(__BTree *tree, __BTreeLayout layout, bool leaf) {
+  __BTreeNode **freeList = leaf ? &tree->freeLeaves : &tree->freeInner;
+  __BTreeNode *node = *freeList;
+  if (node) {
+    *freeList = *(__BTreeNode **)node->data;
+  } else {
+    size_t size = sizeof(__BTreeNode) + btreeChildrenOffset(layout);
+    if (!leaf) {
+      size += (btreeMaxKeys(layout) + 1) * sizeof(__BTreeNode *);
+    }
+    node = tree->arena ? (__BTreeNode *)ArenaAlloc(tree->arena, size) : (__BTreeNode *)Malloc(size);
+  }
+  node->count = 0;
+  node->leaf = leaf;
+  return node;
+}
+
+static void btreeFreeNode(__BTree *tree, __BTreeNode *node) {
+  if (!tree->arena) {
+    Free(node);
+    return;
+  }
+  __BTreeNode **freeList = node->leaf ? &tree->freeLeaves : &tree->freeInner;
+  *(__BTreeNode **)node->data = *freeList;
+  *freeList = node;
+}
+
+// Moves `count` entries (and the child right after each one for inner nodes) inside or between nodes
+static void btreeMoveEntries(__BTreeLayout layout, __BTreeNode *dst, size_t dstIndex, __BTreeNode *src, size_t srcIndex, size_t count) {
+  memmove(btreeKey(layout, dst, dstIndex), btreeKey(layout, src, srcIndex), count * layout.keySize);
+  memmove(btreeValue(layout, dst, dstIndex), btreeValue(layout, src, srcIndex), count * layout.valueSize);
+}
+
+static void btreeMoveChildren(__BTreeLayout layout, __BTreeNode *dst, size_t dstIndex, __BTreeNode *src, size_t srcIndex, size_t count) {
+  memmove(&btreeChildren(layout, dst)[dstIndex], &btreeChildren(layout, src)[srcIndex], count * sizeof(__BTreeNode *));
+}
+
+// First index whose key is greater or equal than `key`
+static size_t btreeSearch(__BTreeLayout layout, __BTreeNode *node, const void *key, bool *found) {
+  size_t low = 0;
+  size_t high = node->count;
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    if (layout.compare(btreeKey(layout, node, mid), key) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  *found = low < node->count && layout.compare(btreeKey(layout, node, low), key) == 0;
+  return low;
+}
+
+// Splits the full child `index` of `parent`, its middle entry moves up into `parent`
+static void btreeSplitChild(__BTree *tree, __BTreeLayout layout, __BTreeNode *parent, size_t index) {
+  size_t t = btreeDegree(layout);
+  __BTreeNode *left = btreeChildren(layout, parent)[index];
+  __BTreeNode *right = btreeNewNode(tree, layout, left->leaf);
+
+  btreeMoveEntries(layout, right, 0, left, t, t - 1);
+  if (!left->leaf) {
+    btreeMoveChildren(layout, right, 0, left, t, t);
+  }
+  right->count = t - 1;
+  left->count = t - 1;
+
+  btreeMoveEntries(layout, parent, index + 1, parent, index, parent->count - index);
+  btreeMoveChildren(layout, parent, index + 2, parent, index + 1, parent->count - index);
+  btreeMoveEntries(layout, parent, index, left, t - 1, 1);
+  btreeChildren(layout, parent)[index + 1] = right;
+  parent->count++;
+}
+
+// Merges child `index + 1` and the separating entry into child `index`
+static void btreeMerge(__BTree *tree, __BTreeLayout layout, __BTreeNode *node, size_t index) {
+  __BTreeNode *left = btreeChildren(layout, node)[index];
+  __BTreeNode *right = btreeChildren(layout, node)[index + 1];
+
+  btreeMoveEntries(layout, left, left->count, node, index, 1);
+  btreeMoveEntries(layout, left, left->count + 1, right, 0, right->count);
+  if (!left->leaf) {
+    btreeMoveChildren(layout, left, left->count + 1, right, 0, right->count + 1);
+  }
+  left->count += right->count + 1;
+
+  btreeMoveEntries(layout, node, index, node, index + 1, node->count - index - 1);
+  btreeMoveChildren(layout, node, index + 1, node, index + 2, node->count - index - 1);
+  node->count--;
+  btreeFreeNode(tree, right);
+}
+
+// Makes sure child `index` has at least `t` keys before descending into it, returns the child to descend into
+static __BTreeNode *btreeFillChild(__BTree *tree, __BTreeLayout layout, __BTreeNode *node, size_t index) {
+  size_t t = btreeDegree(layout);
+  __BTreeNode **children = btreeChildren(layout, node);
+  __BTreeNode *child = children[index];
+  if (child->count >= t) {
+    return child;
+  }
+
+  if (index > 0 && children[index - 1]->count >= t) {
+    // Rotate right, borrow the last entry of the left sibling through the parent
+    __BTreeNode *left = children[index - 1];
+    btreeMoveEntries(layout, child, 1, child, 0, child->count);
+    btreeMoveEntries(layout, child, 0, node, index - 1, 1);
+    if (!child->leaf) {
+      btreeMoveChildren(layout, child, 1, child, 0, child->count + 1);
+      btreeChildren(layout, child)[0] = btreeChildren(layout, left)[left->count];
+    }
+    btreeMoveEntries(layout, node, index - 1, left, left->count - 1, 1);
+    left->count--;
+    child->count++;
+    return child;
+  }
+
+  if (index < node->count && children[index + 1]->count >= t) {
+    // Rotate left, borrow the first entry of the right sibling through the parent
+    __BTreeNode *right = children[index + 1];
+    btreeMoveEntries(layout, child, child->count, node, index, 1);
+    if (!child->leaf) {
+      btreeChildren(layout, child)[child->count + 1] = btreeChildren(layout, right)[0];
+      btreeMoveChildren(layout, right, 0, right, 1, right->count);
+    }
+    btreeMoveEntries(layout, node, index, right, 0, 1);
+    btreeMoveEntries(layout, right, 0, right, 1, right->count - 1);
+    right->count--;
+    child->count++;
+    return child;
+  }
+
+  if (index < node->count) {
+    btreeMerge(tree, layout, node, index);
+    return child;
+  }
+  btreeMerge(tree, layout, node, index - 1);
+  return children[index - 1];
+}
+
+static bool btreeRemove(__BTree *tree, __BTreeLayout layout, __BTreeNode *node, const void *key) {
+  size_t t = btreeDegree(layout);
+  for (;;) {
+    bool found;
+    size_t index = btreeSearch(layout, node, key, &found);
+    if (node->leaf) {
+      if (!found) {
+        return false;
+      }
+      btreeMoveEntries(layout, node, index, node, index + 1, node->count - index - 1);
+      node->count--;
+      return true;
+    }
+
+    if (!found) {
+      node = btreeFillChild(tree, layout, node, index);
+      continue;
+    }
+
+    // NOTE: Replace with the predecessor or successor and remove that one from the child instead
+    __BTreeNode *left = btreeChildren(layout, node)[index];
+    __BTreeNode *right = btreeChildren(layout, node)[index + 1];
+    if (left->count >= t) {
+      __BTreeNode *last = left;
+      while (!last->leaf) last = btreeChildren(layout, last)[last->count];
+      btreeMoveEntries(layout, node, index, last, last->count - 1, 1);
+      key = btreeKey(layout, node, index);
+      node = left;
+    } else if (right->count >= t) {
+      __BTreeNode *first = right;
+      while (!first->leaf) first = btreeChildren(layout, first)[0];
+      btreeMoveEntries(layout, node, index, first, 0, 1);
+      key = btreeKey(layout, node, index);
+      node = right;
+    } else {
+      btreeMerge(tree, layout, node, index);
+      node = left;
+    }
+  }
+}
+
+void *__BTreePut(__BTree *tree, __BTreeLayout layout, const void *key, const void *value) {
+  if (!tree->root) {
+    tree->root = btreeNewNode(tree, layout, true);
+  }
+
+  if (tree->root->count == btreeMaxKeys(layout)) {
+    __BTreeNode *root = btreeNewNode(tree, layout, false);
+    btreeChildren(layout, root)[0] = tree->root;
+    tree->root = root;
+    btreeSplitChild(tree, layout, root, 0);
+  }
+
+  // NOTE: Splits full nodes on the way down so there is always room to insert into the leaf
+  __BTreeNode *node = tree->root;
+  for (;;) {
+    bool found;
+    size_t index = btreeSearch(layout, node, key, &found);
+    if (!found && !node->leaf) {
+      if (btreeChildren(layout, node)[index]->count == btreeMaxKeys(layout)) {
+        btreeSplitChild(tree, layout, node, index);
+        i32 order = layout.compare(key, btreeKey(layout, node, index));
+        found = order == 0;
+        index += order > 0;
+      }
+      if (!found) {
+        node = btreeChildren(layout, node)[index];
+        continue;
+      }
+    }
+
+    if (!found) {
+      btreeMoveEntries(layout, node, index + 1, node, index, node->count - index);
+      memcpy(btreeKey(layout, node, index), key, layout.keySize);
+      node->count++;
+      tree->length++;
+    }
+    memcpy(btreeValue(layout, node, index), value, layout.valueSize);
+    return btreeValue(layout, node, index);
+  }
+}
+
+void *__BTreeGet(__BTree *tree, __BTreeLayout layout, const void *key) {
+  __BTreeNode *node = tree->root;
+  while (node) {
+    bool found;
+    size_t index = btreeSearch(layout, node, key, &found);
+    if (found) {
+      return btreeValue(layout, node, index);
+    }
+    node = node->leaf ? NULL : btreeChildren(layout, node)[index];
+  }
+  return NULL;
+}
+
+bool __BTreeRemove(__BTree *tree, __BTreeLayout layout, const void *key) {
+  if (!tree->root || !btreeRemove(tree, layout, tree->root, key)) {
+    return false;
+  }
+  tree->length--;
+
+  __BTreeNode *root = tree->root;
+  if (root->count == 0) {
+    tree->root = root->leaf ? NULL : btreeChildren(layout, root)[0];
+    btreeFreeNode(tree, root);
+  }
+  return true;
+}
+
+static void btreeIterLoad(__BTreeLayout layout, BTreeIter *it) {
+  // NOTE: Climb until an ancestor still has an entry left to visit
+  while (it->depth >= 0 && it->indices[it->depth] >= it->nodes[it->depth]->count) {
+    it->depth--;
+  }
+
+  if (it->depth < 0) {
+    it->key = NULL;
+    it->value = NULL;
+    return;
+  }
+  __BTreeNode *node = it->nodes[it->depth];
+  it->key = btreeKey(layout, node, it->indices[it->depth]);
+  it->value = btreeValue(layout, node, it->indices[it->depth]);
+}
+
+// NOTE: Every node in the stack points at the entry visited once its current child is done
+BTreeIter __BTreeLowerBound(__BTree *tree, __BTreeLayout layout, const void *key) {
+  BTreeIter it = {.depth = -1};
+  __BTreeNode *node = tree->root;
+  while (node) {
+    bool found = false;
+    size_t index = key ? btreeSearch(layout, node, key, &found) : 0;
+    it.depth++;
+    assert(it.depth < __BTREE_MAX_DEPTH && "BTree: max depth exceeded");
+    it.nodes[it.depth] = node;
+    it.indices[it.depth] = index;
+    if (found || node->leaf) {
+      break;
+    }
+    node = btreeChildren(layout, node)[index];
+  }
+  btreeIterLoad(layout, &it);
+  return it;
+}
+
+void __BTreeNext(__BTreeLayout layout, BTreeIter *it) {
+  __BTreeNode *node = it->nodes[it->depth];
+  it->indices[it->depth]++;
+  if (!node->leaf) {
+    node = btreeChildren(layout, node)[it->indices[it->depth]];
+    while (node) {
+      it->depth++;
+      assert(it->depth < __BTREE_MAX_DEPTH && "BTree: max depth exceeded");
+      it->nodes[it->depth] = node;
+      it->indices[it->depth] = 0;
+      node = node->leaf ? NULL : btreeChildren(layout, node)[0];
+    }
+  }
+  btreeIterLoad(layout, it);
+}
+
+void __BTreeBuild(__BTree *tree, __BTreeLayout layout, const void *keys, const void *values, size_t count) {
+  assert(tree->root == NULL && "BTreeBuild: tree must be empty");
+  if (count == 0) {
+    return;
+  }
+
+  // NOTE: Built level by level from the leaves up, each level spreads its entries evenly across
+  // `ceil((count + 1) / (maxKeys + 1))` nodes, which keeps every node at least half full
+  size_t maxKeys = btreeMaxKeys(layout);
+  tree->length = count;
+  char *levelKeys = (char *)Malloc(count * layout.keySize);
+  char *levelValues = (char *)Malloc(count * layout.valueSize);
+  __BTreeNode **children = NULL;
+  memcpy(levelKeys, keys, count * layout.keySize);
+  memcpy(levelValues, values, count * layout.valueSize);
+
+  for (;;) {
+    size_t nodeCount = (count + 1 + maxKeys) / (maxKeys + 1);
+    size_t perNode = (count - (nodeCount - 1)) / nodeCount;
+    size_t extra = (count - (nodeCount - 1)) % nodeCount;
+    __BTreeNode **nodes = (__BTreeNode **)Malloc(nodeCount * sizeof(__BTreeNode *));
+
+    size_t position = 0;
+    size_t childPosition = 0;
+    for (size_t i = 0; i < nodeCount; i++) {
+      size_t keysInNode = perNode + (i < extra);
+      __BTreeNode *node = btreeNewNode(tree, layout, children == NULL);
+      memcpy(btreeKey(layout, node, 0), levelKeys + position * layout.keySize, keysInNode * layout.keySize);
+      memcpy(btreeValue(layout, node, 0), levelValues + position * layout.valueSize, keysInNode * layout.valueSize);
+      if (children) {
+        memcpy(btreeChildren(layout, node), children + childPosition, (keysInNode + 1) * sizeof(__BTreeNode *));
+        childPosition += keysInNode + 1;
+      }
+      node->count = keysInNode;
+      nodes[i] = node;
+      position += keysInNode;
+
+      // NOTE: The entry between two nodes becomes a separator one level up, compacted in place
+      if (i + 1 < nodeCount) {
+        memmove(levelKeys + i * layout.keySize, levelKeys + position * layout.keySize, layout.keySize);
+        memmove(levelValues + i * layout.valueSize, levelValues + position * layout.valueSize, layout.valueSize);
+        position++;
+      }
+    }
+
+    Free(children);
+    children = nodes;
+    count = nodeCount - 1;
+    if (nodeCount == 1) {
+      break;
+    }
+  }
+
+  tree->root = children[0];
+  Free(children);
+  Free(levelKeys);
+  Free(levelValues);
+}
+
+static void btreeFreeNodes(__BTreeLayout layout, __BTreeNode *node) {
+  if (!node->leaf) {
+    for (size_t i = 0; i <= node->count; i++) {
+      btreeFreeNodes(layout, btreeChildren(layout, node)[i]);
+    }
+  }
+  Free(node);
+}
+
+void __BTreeFree(__BTree *tree, __BTreeLayout layout) {
+  if (!tree->arena && tree->root) {
+    btreeFreeNodes(layout, tree->root);
+  }
+  Arena *arena = tree->arena;
+  memset(tree, 0, sizeof(*tree));
+  tree->arena = arena;
+}
+
+/* Radix Tree Implementation */
+enum { __RADIX_LEAF, __RADIX_NODE4, __RADIX_NODE16, __RADIX_NODE48, __RADIX_NODE256 };
+
+struct __RadixNode {
+  u8 type;
+  u16 count;
+  u32 prefixLength;
+  const char *prefix; // NOTE: Points into the key copy of some leaf below, so it never needs its own storage
+  struct __RadixLeaf *terminal; // NOTE: Key that ends exactly after this node's prefix
+};
+
+typedef struct __RadixLeaf {
+  __RadixNode header;
+  String key;
+  void *value;
+} __RadixLeaf;
+
+typedef struct {
+  __RadixNode header;
+  u8 keys[4]; // NOTE: Sorted, so iteration is in byte order
+  __RadixNode *children[4];
+} __RadixNode4;
+
+typedef struct {
+  __RadixNode header;
+  u8 keys[16];
+  __RadixNode *children[16];
+} __RadixNode16;
+
+typedef struct {
+  __RadixNode header;
+  u8 index[256]; // NOTE: Slot + 1 in `children`, 0 when missing
+  __RadixNode *children[48];
+} __RadixNode48;
+
+typedef struct {
+  __RadixNode header;
+  __RadixNode *children[256];
+} __RadixNode256;
+
+static __RadixNode *radixNewNode(RadixTree *tree, u8 type) {
+  size_t sizes[] = {sizeof(__RadixLeaf), sizeof(__RadixNode4), sizeof(__RadixNode16), sizeof(__RadixNode48), sizeof(__RadixNode256)};
+  __RadixNode *node = (__RadixNode *)ArenaAlloc(tree->arena, sizes[type]);
+  node->type = type;
+  return node;
+}
+
+static __RadixLeaf *radixNewLeaf(RadixTree *tree, String *key, void *value) {
+  __RadixLeaf *leaf = (__RadixLeaf *)radixNewNode(tree, __RADIX_LEAF);
+  leaf->key = StrNewSize(tree->arena, key->data, key->length);
+  leaf->value = value;
+  return leaf;
+}
+
+static __RadixNode **radixFindChild(__RadixNode *node, u8 byte) {
+  switch (node->type) {
+  case __RADIX_NODE4: {
+    __RadixNode4 *node4 = (__RadixNode4 *)node;
+    for (u32 i = 0; i < node->count; i++) {
+      if (node4->keys[i] == byte) return &node4->children[i];
+    }
+    return NULL;
+  }
+  case __RADIX_NODE16: {
+    __RadixNode16 *node16 = (__RadixNode16 *)node;
+#  if defined(BASE_SSE2)
+    __m128i keys = _mm_loadu_si128((const __m128i *)node16->keys);
+    u32 matches = _mm_movemask_epi8(_mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte))) & ((1u << node->count) - 1);
+    return matches ? &node16->children[__BitCtz64(matches)] : NULL;
+#  else
+    for (u32 i = 0; i < node->count; i++) {
+      if (node16->keys[i] == byte) return &node16->children[i];
+    }
+    return NULL;
+#  endif
+  }
+  case __RADIX_NODE48: {
+    __RadixNode48 *node48 = (__RadixNode48 *)node;
+    return node48->index[byte] ? &node48->children[node48->index[byte] - 1] : NULL;
+  }
+  case __RADIX_NODE256: {
+    __RadixNode256 *node256 = (__RadixNode256 *)node;
+    return node256->children[byte] ? &node256->children[byte] : NULL;
+  }
+  }
+  return NULL;
+}
+
+// Inserts into a sorted key array, shared by node4 and node16
+static void radixInsertSorted(u8 *keys, __RadixNode **children, u16 count, u8 byte, __RadixNode *child) {
+  u16 position = 0;
+  while (position < count && keys[position] < byte) {
+    position++;
+  }
+  memmove(keys + position + 1, keys + position, count - position);
+  memmove(children + position + 1, children + position, (count - position) * sizeof(__RadixNode *));
+  keys[position] = byte;
+  children[position] = child;
+}
 
-    while (pos < end && *pos != '\n') {
-      pos++;
+// Adds a child, growing the node into the next size (and updating `ref`) when full
+static void radixAddChild(RadixTree *tree, __RadixNode **ref, u8 byte, __RadixNode *child) {
+  __RadixNode *node = *ref;
+  switch (node->type) {
+  case __RADIX_NODE4: {
+    __RadixNode4 *node4 = (__RadixNode4 *)node;
+    if (node->count < 4) {
+      radixInsertSorted(node4->keys, node4->children, node->count++, byte, child);
+      return;
+    }
+    __RadixNode16 *node16 = (__RadixNode16 *)radixNewNode(tree, __RADIX_NODE16);
+    node16->header = *node;
+    node16->header.type = __RADIX_NODE16;
+    memcpy(node16->keys, node4->keys, 4);
+    memcpy(node16->children, node4->children, 4 * sizeof(__RadixNode *));
+    *ref = &node16->header;
+    radixAddChild(tree, ref, byte, child);
+    return;
+  }
+  case __RADIX_NODE16: {
+    __RadixNode16 *node16 = (__RadixNode16 *)node;
+    if (node->count < 16) {
+      radixInsertSorted(node16->keys, node16->children, node->count++, byte, child);
+      return;
+    }
+    __RadixNode48 *node48 = (__RadixNode48 *)radixNewNode(tree, __RADIX_NODE48);
+    node48->header = *node;
+    node48->header.type = __RADIX_NODE48;
+    for (u32 i = 0; i < 16; i++) {
+      node48->index[node16->keys[i]] = i + 1;
+      node48->children[i] = node16->children[i];
     }
-
-    size_t len = pos - curr;
-
-    if (pos < end && pos > curr && *(pos - 1) == '\r') {
-      len--;
+    *ref = &node48->header;
+    radixAddChild(tree, ref, byte, child);
+    return;
+  }
+  case __RADIX_NODE48: {
+    __RadixNode48 *node48 = (__RadixNode48 *)node;
+    if (node->count < 48) {
+      u32 slot = 0;
+      while (node48->children[slot]) slot++; // NOTE: Removals can leave holes
+      node48->children[slot] = child;
+      node48->index[byte] = slot + 1;
+      node->count++;
+      return;
     }
-
-    String currString = StrNewSize(arena, curr, len);
-    VecPush(result, currString);
-
-    if (pos < end) {
-      curr = pos + 1;
-    } else {
-      break;
+    __RadixNode256 *node256 = (__RadixNode256 *)radixNewNode(tree, __RADIX_NODE256);
+    node256->header = *node;
+    node256->header.type = __RADIX_NODE256;
+    for (u32 i = 0; i < 256; i++) {
+      if (node48->index[i]) node256->children[i] = node48->children[node48->index[i] - 1];
     }
+    *ref = &node256->header;
+    radixAddChild(tree, ref, byte, child);
+    return;
+  }
+  case __RADIX_NODE256: {
+    ((__RadixNode256 *)node)->children[byte] = child;
+    node->count++;
+    return;
+  }
   }
+}
 
-  return result;
+static void radixRemoveChild(__RadixNode *node, u8 byte) {
+  switch (node->type) {
+  case __RADIX_NODE4:
+  case __RADIX_NODE16: {
+    u8 *keys = node->type == __RADIX_NODE4 ? ((__RadixNode4 *)node)->keys : ((__RadixNode16 *)node)->keys;
+    __RadixNode **children = node->type == __RADIX_NODE4 ? ((__RadixNode4 *)node)->children : ((__RadixNode16 *)node)->children;
+    u16 position = 0;
+    while (keys[position] != byte) position++;
+    memmove(keys + position, keys + position + 1, node->count - position - 1);
+    memmove(children + position, children + position + 1, (node->count - position - 1) * sizeof(__RadixNode *));
+    break;
+  }
+  case __RADIX_NODE48: {
+    __RadixNode48 *node48 = (__RadixNode48 *)node;
+    node48->children[node48->index[byte] - 1] = NULL;
+    node48->index[byte] = 0;
+    break;
+  }
+  case __RADIX_NODE256:
+    ((__RadixNode256 *)node)->children[byte] = NULL;
+    break;
+  }
+  node->count--;
 }
 
-void StringToUpper(String *str) {
-  for (size_t i = 0; i < str->length; ++i) {
-    char currChar = str->data[i];
-    str->data[i] = toupper(currChar);
+static __RadixLeaf *radixAnyLeaf(__RadixNode *node) {
+  while (node->type != __RADIX_LEAF) {
+    if (node->terminal) return node->terminal;
+    __RadixNode **child = NULL;
+    for (u32 byte = 0; !child; byte++) child = radixFindChild(node, byte);
+    node = *child;
   }
+  return (__RadixLeaf *)node;
 }
 
-void StrToLower(String *str) {
-  for (size_t i = 0; i < str->length; ++i) {
-    char currChar = str->data[i];
-    str->data[i] = tolower(currChar);
+// After a removal a node left with a single child (and no key ending in it) is merged into that child,
+// so every inner node keeps at least two keys below it
+static void radixCollapse(__RadixNode **ref, size_t depth) {
+  __RadixNode *node = *ref;
+  if (node->count == 0) {
+    *ref = &node->terminal->header;
+    return;
+  }
+  if (node->count > 1 || node->terminal) {
+    return;
+  }
+
+  __RadixNode **only = NULL;
+  for (u32 byte = 0; !only; byte++) only = radixFindChild(node, byte);
+  __RadixNode *child = *only;
+  if (child->type != __RADIX_LEAF) {
+    // NOTE: The merged prefix is `prefix + byte + child prefix`, contiguous inside any key below it
+    __RadixLeaf *leaf = radixAnyLeaf(child);
+    child->prefix = leaf->key.data + depth;
+    child->prefixLength += node->prefixLength + 1;
   }
+  *ref = child;
 }
 
-bool isSpace(char character) {
-  return character == ' ' || character == '\n' || character == '\t' || character == '\r';
+void RadixTreeInit(RadixTree *tree, Arena *arena) {
+  memset(tree, 0, sizeof(*tree));
+  tree->arena = arena;
 }
 
-void StrTrim(String *str) {
-  char *firstChar = NULL;
-  char *lastChar = NULL;
-  if (str->length == 0) {
-    return;
+static size_t radixPrefixMismatch(__RadixNode *node, String *key, size_t depth) {
+  size_t limit = Min(node->prefixLength, key->length - depth);
+  size_t i = 0;
+  while (i < limit && node->prefix[i] == key->data[depth + i]) {
+    i++;
   }
+  return i;
+}
 
-  if (str->length == 1) {
-    if (isSpace(str->data[0])) {
-      str->data[0] = '\0';
-      str->length = 0;
+bool RadixTreeInsert(RadixTree *tree, String *key, void *value) {
+  __RadixNode **ref = &tree->root;
+  size_t depth = 0;
+  for (;;) {
+    __RadixNode *node = *ref;
+    if (!node) {
+      *ref = &radixNewLeaf(tree, key, value)->header;
+      tree->length++;
+      return true;
     }
-    return;
-  }
 
-  for (size_t i = 0; i < str->length; ++i) {
-    char *currChar = &str->data[i];
-    if (isSpace(*currChar)) {
-      continue;
+    if (node->type == __RADIX_LEAF) {
+      __RadixLeaf *leaf = (__RadixLeaf *)node;
+      if (StrEqual(&leaf->key, key)) {
+        leaf->value = value;
+        return false;
+      }
+
+      // NOTE: Split the leaf into a node4 holding the common part of both keys as its prefix
+      __RadixLeaf *newLeaf = radixNewLeaf(tree, key, value);
+      __RadixNode *split = radixNewNode(tree, __RADIX_NODE4);
+      size_t common = 0;
+      while (depth + common < Min(leaf->key.length, key->length) && leaf->key.data[depth + common] == key->data[depth + common]) {
+        common++;
+      }
+      split->prefix = newLeaf->key.data + depth;
+      split->prefixLength = common;
+      *ref = split;
+
+      depth += common;
+      __RadixLeaf *leaves[] = {leaf, newLeaf};
+      for (u32 i = 0; i < 2; i++) {
+        if (leaves[i]->key.length == depth) {
+          split->terminal = leaves[i];
+        } else {
+          radixAddChild(tree, ref, leaves[i]->key.data[depth], &leaves[i]->header);
+        }
+      }
+      tree->length++;
+      return true;
     }
 
-    if (firstChar == NULL) {
-      firstChar = currChar;
+    if (node->prefixLength) {
+      size_t common = radixPrefixMismatch(node, key, depth);
+      if (common < node->prefixLength) {
+        // NOTE: Key diverges inside the prefix, split it with a node4 above this one
+        __RadixLeaf *newLeaf = radixNewLeaf(tree, key, value);
+        __RadixNode *split = radixNewNode(tree, __RADIX_NODE4);
+        split->prefix = node->prefix;
+        split->prefixLength = common;
+        *ref = split;
+
+        u8 byte = node->prefix[common];
+        node->prefix += common + 1;
+        node->prefixLength -= common + 1;
+        radixAddChild(tree, ref, byte, node);
+        if (key->length == depth + common) {
+          split->terminal = newLeaf;
+        } else {
+          radixAddChild(tree, ref, key->data[depth + common], &newLeaf->header);
+        }
+        tree->length++;
+        return true;
+      }
+      depth += node->prefixLength;
     }
-    lastChar = currChar;
-  }
 
-  if (firstChar == NULL || lastChar == NULL) {
-    str->data[0] = '\0';
-    str->length = 0;
-    addNullTerminator(str->data, 0);
-    return;
-  }
+    if (depth == key->length) {
+      if (node->terminal) {
+        node->terminal->value = value;
+        return false;
+      }
+      node->terminal = radixNewLeaf(tree, key, value);
+      tree->length++;
+      return true;
+    }
 
-  size_t len = (lastChar - firstChar) + 1;
-  memcpy_s(str->data, str->length, firstChar, len);
-  str->length = len;
-  addNullTerminator(str->data, len);
+    __RadixNode **child = radixFindChild(node, key->data[depth]);
+    if (!child) {
+      radixAddChild(tree, ref, key->data[depth], &radixNewLeaf(tree, key, value)->header);
+      tree->length++;
+      return true;
+    }
+    ref = child;
+    depth++;
+  }
 }
 
-String StrSlice(Arena *arena, String *str, size_t start, size_t end) {
-  assert(start >= 0 && "StrSlice: start index must be non-negative");
-  assert(start <= str->length && "StrSlice: start index out of bounds");
+static __RadixLeaf *radixFind(RadixTree *tree, String *key) {
+  __RadixNode *node = tree->root;
+  size_t depth = 0;
+  while (node) {
+    if (node->type == __RADIX_LEAF) {
+      __RadixLeaf *leaf = (__RadixLeaf *)node;
+      return StrEqual(&leaf->key, key) ? leaf : NULL;
+    }
 
-  if (end < 0) {
-    end = str->length + end;
-  }
+    if (radixPrefixMismatch(node, key, depth) != node->prefixLength) {
+      return NULL;
+    }
+    depth += node->prefixLength;
+    if (depth == key->length) {
+      return node->terminal;
+    }
 
-  assert(end >= start && "StrSlice: end must be greater than or equal to start");
-  assert(end <= str->length && "StrSlice: end index out of bounds");
+    __RadixNode **child = radixFindChild(node, key->data[depth]);
+    node = child ? *child : NULL;
+    depth++;
+  }
+  return NULL;
+}
 
-  size_t len = end - start;
-  return StrNewSize(arena, str->data + start, len);
+void *RadixTreeGet(RadixTree *tree, String *key) {
+  __RadixLeaf *leaf = radixFind(tree, key);
+  return leaf ? leaf->value : NULL;
 }
 
-String F(Arena *arena, const char *format, ...) {
-  va_list args;
-  va_start(args, format);
-  size_t size = vsnprintf(NULL, 0, format, args) + 1; // +1 for null terminator
-  va_end(args);
+bool RadixTreeRemove(RadixTree *tree, String *key) {
+  __RadixNode **parentRef = NULL;
+  size_t parentDepth = 0;
+  __RadixNode **ref = &tree->root;
+  size_t depth = 0;
+  while (*ref) {
+    __RadixNode *node = *ref;
+    if (node->type == __RADIX_LEAF) {
+      if (!StrEqual(&((__RadixLeaf *)node)->key, key)) {
+        return false;
+      }
+      if (!parentRef) {
+        *ref = NULL;
+      } else {
+        radixRemoveChild(*parentRef, key->data[depth - 1]);
+        radixCollapse(parentRef, parentDepth);
+      }
+      tree->length--;
+      return true;
+    }
 
-  char *buffer = ArenaAllocChars(arena, size);
-  va_start(args, format);
-  vsnprintf(buffer, size, format, args);
-  va_end(args);
+    if (radixPrefixMismatch(node, key, depth) != node->prefixLength) {
+      return false;
+    }
+    if (depth + node->prefixLength == key->length) {
+      if (!node->terminal) {
+        return false;
+      }
+      node->terminal = NULL;
+      radixCollapse(ref, depth);
+      tree->length--;
+      return true;
+    }
 
-  return (String){.length = size - 1, .data = buffer};
+    parentRef = ref;
+    parentDepth = depth;
+    depth += node->prefixLength;
+    ref = radixFindChild(node, key->data[depth]);
+    depth++;
+    if (!ref) {
+      return false;
+    }
+  }
+  return false;
 }
 
-String ConvertPath(Arena *arena, String path) {
-  String platform = GetPlatform();
-  String result;
+void *RadixTreeLongestPrefix(RadixTree *tree, String *key, size_t *prefixLength) {
+  __RadixLeaf *best = NULL;
+  __RadixNode *node = tree->root;
+  size_t depth = 0;
+  while (node) {
+    if (node->type == __RADIX_LEAF) {
+      __RadixLeaf *leaf = (__RadixLeaf *)node;
+      if (leaf->key.length <= key->length && memcmp(leaf->key.data + depth, key->data + depth, leaf->key.length - depth) == 0) {
+        best = leaf;
+      }
+      break;
+    }
 
-  if (path.length >= 2 && path.data[0] == '.' && (path.data[1] == '/' || path.data[1] == '\\')) {
-    result = StrNewSize(arena, path.data + 2, path.length - 2);
-    memcpy(result.data, path.data + 2, path.length - 2);
-  } else {
-    result = StrNewSize(arena, path.data, path.length);
-  }
+    if (radixPrefixMismatch(node, key, depth) != node->prefixLength) {
+      break;
+    }
+    depth += node->prefixLength;
+    if (node->terminal) {
+      best = node->terminal;
+    }
+    if (depth == key->length) {
+      break;
+    }
 
-  if (StrEqual(&platform, &S("linux")) || StrEqual(&platform, &S("macos"))) {
-    return result;
+    __RadixNode **child = radixFindChild(node, key->data[depth]);
+    node = child ? *child : NULL;
+    depth++;
   }
 
-  for (size_t i = 0; i < result.length; i++) {
-    if (result.data[i] == '/') {
-      result.data[i] = '\\';
-    }
+  if (prefixLength) {
+    *prefixLength = best ? best->key.length : 0;
   }
-
-  return result;
+  return best ? best->value : NULL;
 }
 
-String ParsePath(Arena *arena, String path) {
-  String result;
-
-  if (path.length >= 2 && path.data[0] == '.' && (path.data[1] == '/' || path.data[1] == '\\')) {
-    result = StrNewSize(arena, path.data + 2, path.length - 2);
-    memcpy(result.data, path.data + 2, path.length - 2);
-  } else {
-    result = StrNewSize(arena, path.data, path.length);
+static bool radixVisit(__RadixNode *node, RadixTreeVisitFn fn, void *userData) {
+  if (node->type == __RADIX_LEAF) {
+    __RadixLeaf *leaf = (__RadixLeaf *)node;
+    return fn(leaf->key, leaf->value, userData);
   }
 
-  return result;
-}
-
-String ConvertExe(Arena *arena, String path) {
-  String platform = GetPlatform();
-  String exeExtension = S(".exe");
+  if (node->terminal && !fn(node->terminal->key, node->terminal->value, userData)) {
+    return false;
+  }
 
-  bool hasExe = false;
-  if (path.length >= exeExtension.length) {
-    String pathEnd = StrSlice(arena, &path, path.length - exeExtension.length, path.length);
-    if (StrEqual(&pathEnd, &exeExtension)) {
-      hasExe = true;
+  switch (node->type) {
+  case __RADIX_NODE4:
+  case __RADIX_NODE16: {
+    __RadixNode **children = node->type == __RADIX_NODE4 ? ((__RadixNode4 *)node)->children : ((__RadixNode16 *)node)->children;
+    for (u32 i = 0; i < node->count; i++) {
+      if (!radixVisit(children[i], fn, userData)) return false;
     }
+    return true;
   }
-
-  if (StrEqual(&platform, &S("windows"))) {
-    if (hasExe) {
-      return path;
+  case __RADIX_NODE48: {
+    __RadixNode48 *node48 = (__RadixNode48 *)node;
+    for (u32 byte = 0; byte < 256; byte++) {
+      if (node48->index[byte] && !radixVisit(node48->children[node48->index[byte] - 1], fn, userData)) return false;
     }
-    return StrConcat(arena, &path, &exeExtension);
+    return true;
   }
-
-  if (StrEqual(&platform, &S("linux")) || StrEqual(&platform, &S("macos"))) {
-    if (hasExe) {
-      return StrSlice(arena, &path, 0, path.length - exeExtension.length);
+  case __RADIX_NODE256: {
+    __RadixNode256 *node256 = (__RadixNode256 *)node;
+    for (u32 byte = 0; byte < 256; byte++) {
+      if (node256->children[byte] && !radixVisit(node256->children[byte], fn, userData)) return false;
     }
-    return path;
+    return true;
   }
+  }
+  return true;
+}
 
-  return path;
+void RadixTreeForEachPrefix(RadixTree *tree, String *prefix, RadixTreeVisitFn fn, void *userData) {
+  __RadixNode *node = tree->root;
+  size_t depth = 0;
+  while (node) {
+    if (node->type == __RADIX_LEAF) {
+      __RadixLeaf *leaf = (__RadixLeaf *)node;
+      if (leaf->key.length >= prefix->length && memcmp(leaf->key.data, prefix->data, prefix->length) == 0) {
+        fn(leaf->key, leaf->value, userData);
+      }
+      return;
+    }
+
+    // NOTE: The prefix can run out in the middle of a node prefix, everything below still matches
+    size_t common = radixPrefixMismatch(node, prefix, depth);
+    if (depth + common == prefix->length) {
+      radixVisit(node, fn, userData);
+      return;
+    }
+    if (common != node->prefixLength) {
+      return;
+    }
+    depth += node->prefixLength;
+
+    __RadixNode **child = radixFindChild(node, prefix->data[depth]);
+    node = child ? *child : NULL;
+    depth++;
+  }
 }
 
 /* Random Implemenation */
@@ -1753,6 +7083,330 @@ FileData *GetDirFiles() {
 }
 #  endif
 
+/* File Cache Implementation */
+// Size and modify time only, unlike `FileStats` it doesn't allocate. Errors map like `FileRead`'s
+static errno_t fileCacheStat(String *path, i64 *size, i64 *modifyTime) {
+#  if defined(PLATFORM_WIN)
+  WIN32_FILE_ATTRIBUTE_DATA fileAttr = {0};
+  if (!GetFileAttributesExA(path->data, GetFileExInfoStandard, &fileAttr)) {
+    DWORD error = GetLastError();
+    return error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND ? FILE_NOT_EXIST : FILE_OPEN_FAILED;
+  }
+  *size = ((i64)fileAttr.nFileSizeHigh << 32) | fileAttr.nFileSizeLow;
+  *modifyTime = ((i64)fileAttr.ftLastWriteTime.dwHighDateTime << 32) | fileAttr.ftLastWriteTime.dwLowDateTime;
+#  else
+  struct stat fileStat;
+  if (stat(path->data, &fileStat) != 0) {
+    return errno == ENOENT ? FILE_NOT_EXIST : FILE_OPEN_FAILED;
+  }
+  *size = fileStat.st_size;
+  *modifyTime = (i64)fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec;
+#  endif
+  return SUCCESS;
+}
+
+static void fileCacheUnlink(FileCache *cache, __FileCacheEntry *entry) {
+  if (entry->prev) entry->prev->next = entry->next;
+  else cache->head = entry->next;
+  if (entry->next) entry->next->prev = entry->prev;
+  else cache->tail = entry->prev;
+  entry->prev = entry->next = NULL;
+}
+
+static void fileCachePushFront(FileCache *cache, __FileCacheEntry *entry) {
+  entry->next = cache->head;
+  if (cache->head) cache->head->prev = entry;
+  cache->head = entry;
+  if (!cache->tail) cache->tail = entry;
+}
+
+static void fileCacheRemove(FileCache *cache, __FileCacheEntry *entry) {
+  fileCacheUnlink(cache, entry);
+  MapRemove(cache->entries, entry->path);
+  cache->bytes -= entry->contents.length;
+  ArenaFree(entry->arena);
+  Free(entry->path.data);
+  Free(entry);
+}
+
+FileCache *FileCacheCreate(size_t maxBytes, i64 ttl) {
+  FileCache *cache = (FileCache *)Malloc(sizeof(FileCache));
+  memset(cache, 0, sizeof(*cache));
+  cache->maxBytes = maxBytes;
+  cache->ttl = ttl;
+  return cache;
+}
+
+errno_t FileCacheRead(FileCache *cache, String *path, String *result) {
+  i64 now = TimeNow();
+  __FileCacheEntry **found = MapGet(cache->entries, *path);
+  __FileCacheEntry *entry = found ? *found : NULL;
+  if (entry && cache->ttl > 0 && now - entry->checkedAt < cache->ttl) {
+    fileCacheUnlink(cache, entry);
+    fileCachePushFront(cache, entry);
+    *result = entry->contents;
+    return SUCCESS;
+  }
+
+  i64 size, modifyTime;
+  errno_t statError = fileCacheStat(path, &size, &modifyTime);
+  if (statError != SUCCESS) {
+    if (entry) fileCacheRemove(cache, entry);
+    return statError;
+  }
+
+  if (entry && entry->size == size && entry->modifyTime == modifyTime) {
+    entry->checkedAt = now;
+    fileCacheUnlink(cache, entry);
+    fileCachePushFront(cache, entry);
+    *result = entry->contents;
+    return SUCCESS;
+  }
+
+  if (entry) {
+    fileCacheRemove(cache, entry);
+  }
+
+  Arena *arena = ArenaCreate(size);
+  String contents;
+  errno_t error = FileRead(arena, path, &contents);
+  if (error != SUCCESS) {
+    ArenaFree(arena);
+    return error;
+  }
+
+  entry = (__FileCacheEntry *)Malloc(sizeof(__FileCacheEntry));
+  memset(entry, 0, sizeof(*entry));
+  entry->path.length = path->length;
+  entry->path.data = (char *)Malloc(path->length + 1);
+  memcpy(entry->path.data, path->data, path->length);
+  entry->path.data[path->length] = '\0';
+  entry->contents = contents;
+  entry->arena = arena;
+  entry->size = size;
+  entry->modifyTime = modifyTime;
+  entry->checkedAt = now;
+  MapPut(cache->entries, entry->path, entry);
+  fileCachePushFront(cache, entry);
+  cache->bytes += contents.length;
+
+  // NOTE: Evict least recently used, an entry bigger than the whole budget is still kept on its own
+  while (cache->bytes > cache->maxBytes && cache->tail != entry) {
+    fileCacheRemove(cache, cache->tail);
+  }
+
+  *result = entry->contents;
+  return SUCCESS;
+}
+
+void FileCacheInvalidate(FileCache *cache, String *path) {
+  __FileCacheEntry **found = MapGet(cache->entries, *path);
+  if (found) {
+    fileCacheRemove(cache, *found);
+  }
+}
+
+void FileCacheFree(FileCache *cache) {
+  while (cache->head) {
+    fileCacheRemove(cache, cache->head);
+  }
+  MapFree(cache->entries);
+  Free(cache);
+}
+
+/* Bloom Filter Implementation */
+#  define __BLOOM_FILTER_MAGIC 0x314d4c42 // "BLM1"
+
+typedef struct {
+  u32 magic;
+  u32 hashCount;
+  u32 blocked;
+  u32 reserved;
+  u64 bitCount;
+} __BloomFilterHeader;
+
+// Natural log without depending on libm, only used for sizing
+static f64 bloomLog(f64 x) {
+  const f64 ln2 = 0.69314718055994530942;
+  f64 exponent = 0;
+  while (x >= 2) {
+    x /= 2;
+    exponent++;
+  }
+  while (x < 1) {
+    x *= 2;
+    exponent--;
+  }
+
+  // ln(x) = 2 * atanh((x - 1) / (x + 1)), converges fast for x in [1, 2)
+  f64 z = (x - 1) / (x + 1);
+  f64 term = z;
+  f64 sum = 0;
+  for (i32 i = 1; i < 40; i += 2) {
+    sum += term / i;
+    term *= z * z;
+  }
+  return 2 * sum + exponent * ln2;
+}
+
+// Maps a hash to [0, range) with a multiply instead of a modulo
+static inline u64 bloomReduce(u64 hash, u64 range) {
+  hashMultiply(&hash, &range);
+  return range;
+}
+
+void BloomFilterSize(u64 count, f64 falsePositiveRate, u64 *bitCount, u32 *hashCount) {
+  assert(falsePositiveRate > 0 && falsePositiveRate < 1 && "BloomFilterSize: rate must be between 0 and 1");
+  const f64 ln2 = 0.69314718055994530942;
+  f64 bits = -(f64)Max(count, 1) * bloomLog(falsePositiveRate) / (ln2 * ln2);
+  *bitCount = (((u64)bits + 511) / 512) * 512;
+  *hashCount = (u32)Clamp(1, (u64)((f64)*bitCount / Max(count, 1) * ln2 + 0.5), 32);
+}
+
+BloomFilter BloomFilterCreate(u64 count, f64 falsePositiveRate, bool blocked) {
+  BloomFilter filter = {.blocked = blocked};
+  BloomFilterSize(count, falsePositiveRate, &filter.bitCount, &filter.hashCount);
+  filter.bits = (u64 *)Malloc(filter.bitCount / 8);
+  memset(filter.bits, 0, filter.bitCount / 8);
+  return filter;
+}
+
+// Bits of a key inside its 512 bit block, spread with double hashing
+static void bloomBlockMask(u32 hashCount, u64 hash, u64 mask[8]) {
+  memset(mask, 0, 8 * sizeof(u64));
+  u32 position = (u32)hash;
+  u32 step = (u32)(hash >> 32) | 1;
+  for (u32 i = 0; i < hashCount; i++) {
+    u32 bit = position & 511;
+    mask[bit >> 6] |= (u64)1 << (bit & 63);
+    position += step;
+  }
+}
+
+static void bloomAdd(BloomFilter *filter, Hash128 hash) {
+  if (filter->blocked) {
+    u64 *block = filter->bits + bloomReduce(hash.low, filter->bitCount / 512) * 8;
+    u64 mask[8];
+    bloomBlockMask(filter->hashCount, hash.high, mask);
+    for (u32 i = 0; i < 8; i++) {
+      block[i] |= mask[i];
+    }
+    return;
+  }
+
+  u64 step = hash.high | 1;
+  for (u32 i = 0; i < filter->hashCount; i++) {
+    u64 bit = bloomReduce(hash.low + i * step, filter->bitCount);
+    filter->bits[bit >> 6] |= (u64)1 << (bit & 63);
+  }
+}
+
+static bool bloomHas(BloomFilter *filter, Hash128 hash) {
+  if (filter->blocked) {
+    const u64 *block = filter->bits + bloomReduce(hash.low, filter->bitCount / 512) * 8;
+    u64 mask[8];
+    bloomBlockMask(filter->hashCount, hash.high, mask);
+#  if defined(BASE_SSE2)
+    __m128i missing = _mm_setzero_si128();
+    for (u32 i = 0; i < 8; i += 2) {
+      __m128i bits = _mm_loadu_si128((const __m128i *)(block + i));
+      missing = _mm_or_si128(missing, _mm_andnot_si128(bits, _mm_loadu_si128((const __m128i *)(mask + i))));
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) == 0xFFFF;
+#  else
+    u64 missing = 0;
+    for (u32 i = 0; i < 8; i++) {
+      missing |= mask[i] & ~block[i];
+    }
+    return missing == 0;
+#  endif
+  }
+
+  u64 step = hash.high | 1;
+  for (u32 i = 0; i < filter->hashCount; i++) {
+    u64 bit = bloomReduce(hash.low + i * step, filter->bitCount);
+    if (!(filter->bits[bit >> 6] & ((u64)1 << (bit & 63)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilterAdd(BloomFilter *filter, const void *data, size_t length) {
+  bloomAdd(filter, HashBytes128(data, length, 0));
+}
+
+bool BloomFilterHas(BloomFilter *filter, const void *data, size_t length) {
+  return bloomHas(filter, HashBytes128(data, length, 0));
+}
+
+void BloomFilterAddStr(BloomFilter *filter, String *str) {
+  bloomAdd(filter, HashBytes128(str->data, str->length, 0));
+}
+
+bool BloomFilterHasStr(BloomFilter *filter, String *str) {
+  return bloomHas(filter, HashBytes128(str->data, str->length, 0));
+}
+
+bool BloomFilterMerge(BloomFilter *destination, BloomFilter *source) {
+  if (destination->bitCount != source->bitCount || destination->hashCount != source->hashCount || destination->blocked != source->blocked) {
+    return false;
+  }
+
+  for (u64 i = 0; i < destination->bitCount / 64; i++) {
+    destination->bits[i] |= source->bits[i];
+  }
+  return true;
+}
+
+void BloomFilterFree(BloomFilter *filter) {
+  Free(filter->bits);
+  memset(filter, 0, sizeof(*filter));
+}
+
+// NOTE: Stored in native byte order
+errno_t BloomFilterSave(BloomFilter *filter, String *path) {
+  __BloomFilterHeader header = {__BLOOM_FILTER_MAGIC, filter->hashCount, filter->blocked, 0, filter->bitCount};
+  size_t size = sizeof(header) + filter->bitCount / 8;
+  char *buffer = (char *)Malloc(size);
+  memcpy(buffer, &header, sizeof(header));
+  memcpy(buffer + sizeof(header), filter->bits, filter->bitCount / 8);
+
+  String data = {.length = size, .data = buffer};
+  errno_t result = FileWrite(path, &data);
+  Free(buffer);
+  return result;
+}
+
+errno_t BloomFilterLoad(String *path, BloomFilter *filter) {
+  Arena *arena = ArenaCreate(4096);
+  String data;
+  if (FileRead(arena, path, &data) != SUCCESS) {
+    ArenaFree(arena);
+    return BLOOM_FILTER_READ_FAILED;
+  }
+
+  __BloomFilterHeader header;
+  if (data.length < sizeof(header)) {
+    ArenaFree(arena);
+    return BLOOM_FILTER_INVALID_FORMAT;
+  }
+  memcpy(&header, data.data, sizeof(header));
+  if (header.magic != __BLOOM_FILTER_MAGIC || header.hashCount == 0 || header.hashCount > 32 || header.blocked > 1 || header.bitCount == 0 ||
+      header.bitCount % 512 != 0 || data.length - sizeof(header) != header.bitCount / 8) {
+    ArenaFree(arena);
+    return BLOOM_FILTER_INVALID_FORMAT;
+  }
+
+  filter->bitCount = header.bitCount;
+  filter->hashCount = header.hashCount;
+  filter->blocked = header.blocked;
+  filter->bits = (u64 *)Malloc(header.bitCount / 8);
+  memcpy(filter->bits, data.data + sizeof(header), header.bitCount / 8);
+  ArenaFree(arena);
+  return SUCCESS;
+}
+
 /* Logger Implemenation */
 void LogInfo(const char *format, ...) {
   printf("%s[INFO]: ", _GRAY);
@@ -0,0 +1,439 @@
+#define BASE_IMPLEMENTATION
+#include "base.h"
+
+// NOTE: Benchmarks, build with optimizations e.g. `gcc -O2 -std=gnu2x -o base_bench base_bench.c` and run
+// `./base_bench [maxThreads]`, each section logs its own units
+
+#define BENCH_KEYS (1 << 16)
+#define BENCH_OPS_PER_THREAD 2000000
+#define BENCH_MAP_KEYS (1 << 20)
+
+// NOTE: `TimeNow` is in milliseconds, too coarse for the single threaded runs
+static f64 BenchSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+CONCURRENT_MAP_TYPE(BenchConcurrentMap, u64, u64);
+MAP_TYPE(BenchMap, u64, u64);
+
+typedef struct {
+    BenchConcurrentMap* concurrent;
+    BenchMap* locked; // NOTE: Baseline, a regular map behind one global lock
+    RwLock* lock;
+    u32 readPercent;
+    u64 seed;
+} BenchWorker;
+
+static inline u64 BenchNext(u64* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void* BenchConcurrentWorker(void* arg) {
+    BenchWorker* worker = arg;
+    u64 state = worker->seed;
+    u64 sum = 0;
+    for (i32 i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        u64 random = BenchNext(&state);
+        u64 key = random % BENCH_KEYS;
+        if ((random >> 32) % 100 < worker->readPercent) {
+            u64 value;
+            if (ConcurrentMapGet((*worker->concurrent), key, &value)) sum += value;
+        } else {
+            ConcurrentMapPut((*worker->concurrent), key, random);
+        }
+    }
+    return (void*)(uintptr_t)sum;
+}
+
+static void* BenchLockedWorker(void* arg) {
+    BenchWorker* worker = arg;
+    u64 state = worker->seed;
+    u64 sum = 0;
+    for (i32 i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        u64 random = BenchNext(&state);
+        u64 key = random % BENCH_KEYS;
+        RwLockWrite(worker->lock);
+        if ((random >> 32) % 100 < worker->readPercent) {
+            u64* value = MapGet((*worker->locked), key);
+            if (value) sum += *value;
+        } else {
+            MapPut((*worker->locked), key, random);
+        }
+        RwLockWriteUnlock(worker->lock);
+    }
+    return (void*)(uintptr_t)sum;
+}
+
+static f64 BenchRun(void* (*fn)(void*), BenchWorker* base, u32 threadCount) {
+    pthread_t threads[256];
+    BenchWorker workers[256];
+    i64 start = TimeNow();
+    for (u32 t = 0; t < threadCount; t++) {
+        workers[t] = *base;
+        workers[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+        pthread_create(&threads[t], NULL, fn, &workers[t]);
+    }
+    for (u32 t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    f64 seconds = Max(TimeNow() - start, 1) / 1000.0;
+    return (f64)threadCount * BENCH_OPS_PER_THREAD / seconds / 1e6;
+}
+
+static void BenchConcurrentMaps(u32 maxThreads) {
+    static BenchConcurrentMap concurrent;
+    BenchMap locked = {0};
+    RwLock lock;
+    ConcurrentMapInit(concurrent);
+    RwLockInit(&lock);
+    for (u64 key = 0; key < BENCH_KEYS; key++) {
+        ConcurrentMapPut(concurrent, key, key);
+        MapPut(locked, key, key);
+    }
+
+    u32 mixes[] = {100, 90, 50};
+    LogInfo("ConcurrentMap vs global lock map, %d keys, Mops/s", BENCH_KEYS);
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++) {
+        for (u32 threads = 1; threads <= maxThreads; threads *= 2) {
+            BenchWorker base = {.concurrent = &concurrent, .locked = &locked, .lock = &lock, .readPercent = mixes[m]};
+            f64 sharded = BenchRun(BenchConcurrentWorker, &base, threads);
+            f64 global = BenchRun(BenchLockedWorker, &base, threads);
+            LogInfo("reads %3u%% threads %3u: concurrent %8.2f  global lock %8.2f", mixes[m], threads, sharded, global);
+        }
+    }
+
+    ConcurrentMapFree(concurrent);
+    MapFree(locked);
+    RwLockDestroy(&lock);
+}
+
+/* --- Swiss table vs chained table --- */
+MAP_TYPE(BenchIntMap, u64, u64);
+MAP_TYPE(BenchStrMap, String, u64);
+
+// NOTE: Baseline, one heap node per entry behind a power of two bucket array, like a textbook or
+// `std::unordered_map` table. Stores the hash to skip most key compares
+typedef struct BenchChainNode {
+    struct BenchChainNode* next;
+    u64 hash;
+    u64 intKey;
+    String strKey;
+    u64 value;
+} BenchChainNode;
+
+typedef struct {
+    BenchChainNode** buckets;
+    size_t bucketCount;
+    size_t length;
+    bool stringKeys;
+} BenchChainMap;
+
+static u64 BenchChainHash(BenchChainMap* map, u64 intKey, String* strKey) {
+    return map->stringKeys ? StrHash(strKey) : HashBytes(&intKey, sizeof(intKey), 0);
+}
+
+static BenchChainNode** BenchChainFind(BenchChainMap* map, u64 hash, u64 intKey, String* strKey) {
+    BenchChainNode** link = &map->buckets[hash & (map->bucketCount - 1)];
+    for (; *link; link = &(*link)->next) {
+        BenchChainNode* node = *link;
+        if (node->hash == hash && (map->stringKeys ? StrEqual(&node->strKey, strKey) : node->intKey == intKey)) break;
+    }
+    return link;
+}
+
+static void BenchChainPut(BenchChainMap* map, u64 intKey, String strKey, u64 value) {
+    if (map->length >= map->bucketCount) {
+        size_t bucketCount = map->bucketCount ? map->bucketCount * 2 : 16;
+        BenchChainNode** buckets = Malloc(bucketCount * sizeof(*buckets));
+        memset(buckets, 0, bucketCount * sizeof(*buckets));
+        for (size_t i = 0; i < map->bucketCount; i++) {
+            for (BenchChainNode* node = map->buckets[i]; node;) {
+                BenchChainNode* next = node->next;
+                node->next = buckets[node->hash & (bucketCount - 1)];
+                buckets[node->hash & (bucketCount - 1)] = node;
+                node = next;
+            }
+        }
+        Free(map->buckets);
+        map->buckets = buckets;
+        map->bucketCount = bucketCount;
+    }
+    u64 hash = BenchChainHash(map, intKey, &strKey);
+    BenchChainNode** link = BenchChainFind(map, hash, intKey, &strKey);
+    if (*link) {
+        (*link)->value = value;
+        return;
+    }
+    BenchChainNode* node = Malloc(sizeof(*node));
+    *node = (BenchChainNode){.hash = hash, .intKey = intKey, .strKey = strKey, .value = value};
+    *link = node;
+    map->length++;
+}
+
+static u64* BenchChainGet(BenchChainMap* map, u64 intKey, String strKey) {
+    if (map->bucketCount == 0) return NULL;
+    BenchChainNode* node = *BenchChainFind(map, BenchChainHash(map, intKey, &strKey), intKey, &strKey);
+    return node ? &node->value : NULL;
+}
+
+static bool BenchChainRemove(BenchChainMap* map, u64 intKey, String strKey) {
+    if (map->bucketCount == 0) return false;
+    BenchChainNode** link = BenchChainFind(map, BenchChainHash(map, intKey, &strKey), intKey, &strKey);
+    BenchChainNode* node = *link;
+    if (!node) return false;
+    *link = node->next;
+    Free(node);
+    map->length--;
+    return true;
+}
+
+static void BenchChainFree(BenchChainMap* map) {
+    for (size_t i = 0; i < map->bucketCount; i++) {
+        for (BenchChainNode* node = map->buckets[i]; node;) {
+            BenchChainNode* next = node->next;
+            Free(node);
+            node = next;
+        }
+    }
+    Free(map->buckets);
+}
+
+// NOTE: Keys `0..count` present, `count..2 * count` missing, visited in a shuffled order so neither table
+// gets sequential memory access for free
+#define BENCH_MAP_PHASES(phase, insert, hit, miss, remove)                                        \
+    do {                                                                                          \
+        f64 start = BenchSeconds();                                                               \
+        for (size_t i = 0; i < BENCH_MAP_KEYS; i++) insert;                                       \
+        phase[0] = BenchSeconds() - start;                                                        \
+        start = BenchSeconds();                                                                   \
+        for (size_t i = 0; i < BENCH_MAP_KEYS; i++) hit;                                          \
+        phase[1] = BenchSeconds() - start;                                                        \
+        start = BenchSeconds();                                                                   \
+        for (size_t i = BENCH_MAP_KEYS; i < 2 * BENCH_MAP_KEYS; i++) miss;                        \
+        phase[2] = BenchSeconds() - start;                                                        \
+        start = BenchSeconds();                                                                   \
+        for (size_t i = 0; i < BENCH_MAP_KEYS; i++) remove;                                       \
+        phase[3] = BenchSeconds() - start;                                                        \
+    } while (0)
+
+static void BenchMapReport(const char* keys, const char* table, f64 phase[4], u64 check) {
+    LogInfo("%-6s keys %-7s insert %6.1f  hit %6.1f  miss %6.1f  delete %6.1f ns/op (check %llu)", keys, table, phase[0] * 1e9 / BENCH_MAP_KEYS,
+            phase[1] * 1e9 / BENCH_MAP_KEYS, phase[2] * 1e9 / BENCH_MAP_KEYS, phase[3] * 1e9 / BENCH_MAP_KEYS, (unsigned long long)check);
+}
+
+static void BenchMaps() {
+    Arena* arena = ArenaCreate(64 * BENCH_MAP_KEYS);
+    u64* order = Malloc(2 * BENCH_MAP_KEYS * sizeof(u64));
+    String* names = Malloc(2 * BENCH_MAP_KEYS * sizeof(String));
+    u64 state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < 2 * BENCH_MAP_KEYS; i++) {
+        order[i] = i;
+    }
+    // NOTE: Each half shuffled on its own so the present and missing key sets stay disjoint
+    for (size_t half = 0; half < 2; half++) {
+        u64* keys = order + half * BENCH_MAP_KEYS;
+        for (size_t i = BENCH_MAP_KEYS - 1; i > 0; i--) {
+            size_t j = BenchNext(&state) % (i + 1);
+            u64 swap = keys[i];
+            keys[i] = keys[j];
+            keys[j] = swap;
+        }
+    }
+    for (size_t i = 0; i < 2 * BENCH_MAP_KEYS; i++) {
+        names[i] = F(arena, "user:%llu:session", (unsigned long long)order[i]);
+        order[i] *= 0x9E3779B97F4A7C15ULL;
+    }
+
+    LogInfo("MAP_TYPE vs chained table, %d keys", BENCH_MAP_KEYS);
+    f64 phase[4];
+    u64 check = 0;
+
+    BenchIntMap swiss = {0};
+    BENCH_MAP_PHASES(phase, MapPut(swiss, order[i], i), check += *MapGet(swiss, order[i]), check += MapGet(swiss, order[i]) != NULL,
+                     check += MapRemove(swiss, order[i]));
+    BenchMapReport("u64", "swiss", phase, check);
+    MapFree(swiss);
+
+    BenchChainMap chained = {0};
+    check = 0;
+    BENCH_MAP_PHASES(phase, BenchChainPut(&chained, order[i], (String){0}, i), check += *BenchChainGet(&chained, order[i], (String){0}),
+                     check += BenchChainGet(&chained, order[i], (String){0}) != NULL, check += BenchChainRemove(&chained, order[i], (String){0}));
+    BenchMapReport("u64", "chained", phase, check);
+    BenchChainFree(&chained);
+
+    BenchStrMap swissStr = {0};
+    check = 0;
+    BENCH_MAP_PHASES(phase, MapPut(swissStr, names[i], i), check += *MapGet(swissStr, names[i]), check += MapGet(swissStr, names[i]) != NULL,
+                     check += MapRemove(swissStr, names[i]));
+    BenchMapReport("String", "swiss", phase, check);
+    MapFree(swissStr);
+
+    BenchChainMap chainedStr = {.stringKeys = true};
+    check = 0;
+    BENCH_MAP_PHASES(phase, BenchChainPut(&chainedStr, 0, names[i], i), check += *BenchChainGet(&chainedStr, 0, names[i]),
+                     check += BenchChainGet(&chainedStr, 0, names[i]) != NULL, check += BenchChainRemove(&chainedStr, 0, names[i]));
+    BenchMapReport("String", "chained", phase, check);
+    BenchChainFree(&chainedStr);
+
+    Free(order);
+    Free(names);
+    ArenaFree(arena);
+}
+
+/* --- Hashing throughput --- */
+#define BENCH_HASH_BYTES (64 << 20)
+#define BENCH_HASH_CHUNK 1000 // NOTE: Streaming input arrives in pieces that don't line up with the hash blocks
+
+static void BenchHashing() {
+    size_t sizes[] = {4, 16, 64, 256, 4 << 10, 64 << 10, 1 << 20};
+    u8* data = Malloc(1 << 20);
+    u64 state = 0x853C49E6748FEA9BULL;
+    for (size_t i = 0; i < (1 << 20); i++) {
+        data[i] = (u8)BenchNext(&state);
+    }
+
+    LogInfo("Hashing throughput, GB/s");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t size = sizes[s];
+        size_t rounds = BENCH_HASH_BYTES / size;
+        u64 check = 0;
+
+        f64 start = BenchSeconds();
+        for (size_t i = 0; i < rounds; i++) {
+            check += HashBytes(data, size, i);
+        }
+        f64 oneShot = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        for (size_t i = 0; i < rounds; i++) {
+            check += HashBytes128(data, size, i).high;
+        }
+        f64 oneShot128 = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        for (size_t i = 0; i < rounds; i++) {
+            HashState hash;
+            HashInit(&hash, i);
+            for (size_t offset = 0; offset < size; offset += BENCH_HASH_CHUNK) {
+                HashUpdate(&hash, data + offset, Min(size - offset, BENCH_HASH_CHUNK));
+            }
+            check += HashFinal(&hash);
+        }
+        f64 streaming = BenchSeconds() - start;
+
+        f64 bytes = (f64)rounds * size / 1e9;
+        LogInfo("%8zu bytes: HashBytes %6.2f  HashBytes128 %6.2f  streaming %6.2f (check %llu)", size, bytes / oneShot, bytes / oneShot128,
+                bytes / streaming, (unsigned long long)check);
+    }
+    Free(data);
+}
+
+/* --- Splitting --- */
+#define BENCH_SPLIT_BYTES (32 << 20)
+
+// NOTE: Log like fields of 4 to 40 bytes, `memchr` for a byte that never occurs is the memory bandwidth reference
+static void BenchStrSplit() {
+    String delimiters[] = {S(","), S("\r\n"), S("<field/>")};
+    char* buffer = Malloc(BENCH_SPLIT_BYTES + 64);
+    Arena* arena = ArenaCreate(BENCH_SPLIT_BYTES);
+
+    LogInfo("StrSplit over %d MB, GB/s", BENCH_SPLIT_BYTES >> 20);
+    for (size_t d = 0; d < sizeof(delimiters) / sizeof(delimiters[0]); d++) {
+        String* delimiter = &delimiters[d];
+        u64 state = 0xDA942042E4DD58B5ULL;
+        size_t length = 0;
+        while (length < BENCH_SPLIT_BYTES) {
+            u64 random = BenchNext(&state);
+            size_t field = 4 + random % 37;
+            for (size_t i = 0; i < field; i++) {
+                buffer[length++] = "abcdefghijklmnopqrstuvwxyz0123456789 :=/."[(random >> (i % 48)) % 41];
+            }
+            memcpy(buffer + length, delimiter->data, delimiter->length);
+            length += delimiter->length;
+        }
+        String text = {.length = length, .data = buffer};
+        f64 bytes = (f64)length / 1e9;
+
+        f64 start = BenchSeconds();
+        bool found = memchr(buffer, '\x01', length) != NULL;
+        f64 baseline = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        size_t pieces = 0;
+        StrSplitForEach(&text, delimiter, it) {
+            pieces++;
+        }
+        f64 lazy = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        StringVector views = StrSplitView(&text, delimiter);
+        f64 viewed = BenchSeconds() - start;
+
+        start = BenchSeconds();
+        StringVector copies = StrSplit(arena, &text, delimiter);
+        f64 copied = BenchSeconds() - start;
+
+        LogInfo("%zu byte delimiter: memchr %6.2f  StrSplitForEach %6.2f  StrSplitView %6.2f  StrSplit %6.2f (%zu pieces)", delimiter->length,
+                bytes / baseline, bytes / lazy, bytes / viewed, bytes / copied, pieces);
+        if (found || pieces != views.length || pieces != copies.length) {
+            LogError("StrSplit check fail: %zu, %zu, %zu pieces", pieces, views.length, copies.length);
+        }
+        VecFree(views);
+        VecFree(copies);
+        ArenaReset(arena);
+    }
+    ArenaFree(arena);
+    Free(buffer);
+}
+
+/* --- UTF-8 validation --- */
+#define BENCH_UTF8_BYTES (16 << 20)
+#define BENCH_UTF8_ROUNDS 8
+
+// NOTE: The path depends on the build, `-mavx2` for 32 byte blocks, `-mssse3` (or `-march=x86-64-v2`) for 16 byte
+// blocks and plain x86-64 for the scalar decoder with an ASCII skip
+static void BenchUtf8() {
+    const char* samples[] = {"plain ascii log line, ", "caf\xC3\xA9 na\xC3\xAF" "ve \xC3\xBC" "ber ", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E ",
+                             "\xF0\x9F\x98\x80\xF0\x9F\x9A\x80 "};
+    const char* names[] = {"ascii", "latin", "cjk", "emoji"};
+    char* buffer = Malloc(BENCH_UTF8_BYTES + 64);
+    u64 state = 0x6A09E667F3BCC909ULL;
+
+    LogInfo("StrIsValidUtf8 over %d MB, GB/s", BENCH_UTF8_BYTES >> 20);
+    // NOTE: Mixed takes random samples, the branchy scalar path pays for every switch
+    for (size_t text = 0; text <= 4; text++) {
+        size_t length = 0;
+        while (length < BENCH_UTF8_BYTES) {
+            const char* sample = samples[text < 4 ? text : BenchNext(&state) % 4];
+            size_t size = strlen(sample);
+            memcpy(buffer + length, sample, size);
+            length += size;
+        }
+        String str = {.length = length, .data = buffer};
+        size_t valid = 0;
+        f64 start = BenchSeconds();
+        for (i32 i = 0; i < BENCH_UTF8_ROUNDS; i++) {
+            valid += StrIsValidUtf8(&str);
+        }
+        f64 seconds = BenchSeconds() - start;
+        LogInfo("%-6s %6.2f%s", text < 4 ? names[text] : "mixed", (f64)length * BENCH_UTF8_ROUNDS / 1e9 / seconds,
+                valid == BENCH_UTF8_ROUNDS ? "" : " (rejected, bad sample)");
+    }
+    Free(buffer);
+}
+
+int main(int argc, char** argv) {
+    u32 maxThreads = argc > 1 ? (u32)atoi(argv[1]) : (u32)sysconf(_SC_NPROCESSORS_ONLN);
+    maxThreads = Clamp(1, maxThreads, 256);
+    BenchMaps();
+    BenchHashing();
+    BenchStrSplit();
+    BenchUtf8();
+    BenchConcurrentMaps(maxThreads);
+    return 0;
+}
@@ -1,6 +1,10 @@
 #define BASE_IMPLEMENTATION
 #include "base.h"
 
+#if defined(PLATFORM_LINUX)
+#    include <sys/wait.h>
+#endif
+
 static void TestVectors() {
     StringVector vec = {0};
     VecForEach(vec, str) {
@@ -14,6 +18,68 @@ static void TestVectors() {
         LogInfo("%s", str->data);
     }
     VecFree(vec);
+
+    VEC_TYPE(ByteVector, u8);
+    ByteVector bytes = {0};
+    size_t capacities = 0;
+    for (size_t i = 0; i < 100000; i++) {
+        size_t capacity = bytes.capacity;
+        VecPush(bytes, (u8)i);
+        capacities += bytes.capacity != capacity;
+    }
+    if (bytes.capacity != 131072 || capacities != 11 || bytes.data[99999] != (u8)99999) {
+        LogError("Vector growth fail");
+        exit(1);
+    }
+    VecFree(bytes);
+
+    // NOTE: Capacities past I32_MAX still double, only the last doubling that would wrap size_t is refused
+    size_t large = (size_t)I32_MAX + 1;
+    if (__VecNextCapacity(large, 1, 128) != large * 2 || __VecNextCapacity(SIZE_MAX / 4, 2, 128) != SIZE_MAX / 4 * 2) {
+        LogError("Vector large capacity fail");
+        exit(1);
+    }
+#if defined(PLATFORM_LINUX)
+    pid_t child = fork();
+    if (child == 0) {
+        freopen("/dev/null", "w", stderr);
+        __VecNextCapacity(SIZE_MAX / 16 + 1, 8, 128);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGABRT) {
+        LogError("Vector capacity overflow fail");
+        exit(1);
+    }
+#endif
+}
+
+SLOTMAP_TYPE(Entities, i64);
+
+static void TestSlotMaps() {
+    Entities entities = {0};
+    SlotMapHandle handles[100];
+    for (i64 i = 0; i < 100; i++) {
+        handles[i] = SlotMapInsert(entities, i);
+    }
+    for (i32 i = 0; i < 100; i += 3) {
+        SlotMapRemove(entities, handles[i]);
+    }
+    SlotMapHandle reused = SlotMapInsert(entities, 1000);
+    if (SlotMapGet(entities, handles[0]) != NULL || *SlotMapGet(entities, reused) != 1000 || *SlotMapGet(entities, handles[98]) != 98) {
+        LogError("SlotMap lookup fail");
+        exit(1);
+    }
+    i64 sum = 0;
+    SlotMapForEach(entities, it) {
+        sum += *it;
+    }
+    if (SlotMapLength(entities) != 67 || sum != 4950 - 1683 + 1000) {
+        LogError("SlotMap iteration fail");
+        exit(1);
+    }
+    SlotMapFree(entities);
 }
 
 static void TestArenas() {
@@ -33,8 +99,789 @@ static void TestArenas() {
     ArenaFree(a);
 }
 
+static void TestStrSplit() {
+    Arena* a = ArenaCreate(1024);
+    String csv = S("id,name,,email,created_at,updated_at,deleted_at,owner,");
+    StringVector fields = StrSplit(a, &csv, &S(","));
+    String log = S("2024-01-01 ERROR => disk full => retrying in 5s => gave up");
+    StringVector parts = StrSplit(a, &log, &S(" => "));
+    if (fields.length != 8 || fields.data[2].length != 0 || !StrEqual(&fields.data[7], &S("owner"))) {
+        LogError("StrSplit single byte fail");
+        exit(1);
+    }
+    if (parts.length != 4 || !StrEqual(&parts.data[2], &S("retrying in 5s")) || !StrEqual(&parts.data[3], &S("gave up"))) {
+        LogError("StrSplit multi byte fail");
+        exit(1);
+    }
+    String text = S("first\r\nsecond\n\nlast");
+    StringVector lines = StrSplitNewLineView(&text);
+    if (lines.length != 4 || lines.data[1].data != text.data + 7 || !StrEqual(&lines.data[0], &S("first")) || lines.data[2].length != 0) {
+        LogError("StrSplitNewLineView fail");
+        exit(1);
+    }
+    size_t count = 0;
+    StrSplitForEach(&log, &S(" => "), it) {
+        if (!StrEqual(&it.value, &parts.data[count++])) {
+            LogError("StrSplitIter fail");
+            exit(1);
+        }
+    }
+    StrLineIter stream = {0};
+    String chunks[] = {S("first\r"), S("\nsec"), S("ond\n"), S("\nla"), S("st")};
+    count = 0;
+    for (size_t i = 0; i < 5; i++) {
+        StrLineIterFeed(&stream, &chunks[i], i == 4);
+        while (StrLineNext(&stream)) {
+            if (!StrEqual(&stream.line, &lines.data[count++])) {
+                LogError("StrLineIter fail");
+                exit(1);
+            }
+        }
+    }
+    if (count != 4) {
+        LogError("StrLineIter count fail");
+        exit(1);
+    }
+    StrLineIterFree(&stream);
+    String logs = F(a, "%0100d\r\n%070d\n\nlast", 1, 2);
+    StrLineIndex index = StrLineOffsets(a, &logs);
+    String second = StrLineAt(&index, 1);
+    String last = StrLineAt(&index, 3);
+    if (StrCountLines(&logs) != 4 || index.count != 4 || second.length != 70 || StrLineAt(&index, 0).length != 100 || !StrEqual(&last, &S("last"))) {
+        LogError("StrLineOffsets fail");
+        exit(1);
+    }
+    VecFree(fields);
+    VecFree(parts);
+    VecFree(lines);
+    ArenaFree(a);
+}
+
+static void TestStrFind() {
+    String log = S("GET /index.html 200\nGET /missing 404\nPOST /index.html 200\n");
+    if (StrFind(&log, &S("/index.html")) != 4 || StrFindLast(&log, &S("/index.html")) != 42 || StrFind(&log, &S("DELETE")) != -1) {
+        LogError("StrFind fail");
+        exit(1);
+    }
+    if (StrCount(&log, &S(" 200")) != 2 || !StrContains(&log, &S("404")) || !StrStartsWith(&log, &S("GET")) || !StrEndsWith(&log, &S("200\n"))) {
+        LogError("StrCount fail");
+        exit(1);
+    }
+    String empty = {0};
+    if (StrFind(&log, &empty) != 0 || StrFindLast(&log, &empty) != (i64)log.length || !StrContains(&empty, &empty) ||
+        !StrStartsWith(&empty, &empty) || !StrEndsWith(&log, &empty) || StrStartsWith(&empty, &S("GET"))) {
+        LogError("StrFind empty needle fail");
+        exit(1);
+    }
+
+    Arena* a = ArenaCreate(1 << 16);
+    StringBuilder builder = StrBuilderNew(a, 0);
+    for (i32 i = 0; i < 20150; i++) {
+        StrBuilderAppendChar(&builder, i == 20000 ? 'b' : 'a');
+    }
+    String haystack = StrBuilderFinish(&builder);
+    String needle = F(a, "%0300d", 0);
+    memset(needle.data, 'a', 300);
+    needle.data[150] = 'b'; // NOTE: Every position passes the first/last byte filter, forcing the two way fallback
+    if (StrFind(&haystack, &needle) != 20000 - 150 || StrFindLast(&haystack, &needle) != 20000 - 150) {
+        LogError("StrFind periodic fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestStrMatcher() {
+    Arena* a = ArenaCreate(1 << 16);
+    StringVector patterns = {0};
+    StringVectorPushMany(patterns, "he", "she", "his", "hers");
+    StrMatcher matcher = StrMatcherNew(a, &patterns);
+    String text = S("ushers");
+    StrMatchVector matches = StrMatcherFindAll(&matcher, &text);
+    if (matches.length != 3 || matches.data[0].pattern != 1 || matches.data[0].offset != 1 || matches.data[1].pattern != 0 ||
+        matches.data[1].offset != 2 || matches.data[2].pattern != 3 || matches.data[2].offset != 2) {
+        LogError("StrMatcher overlapping fail");
+        exit(1);
+    }
+    VecFree(matches);
+    VecFree(patterns);
+
+    // NOTE: Past the small set limit, so this one runs on the DFA
+    StringVector keywords = {0};
+    for (i32 i = 0; i < 100; i++) {
+        VecPush(keywords, F(a, "error%d", i));
+    }
+    StrMatcher large = StrMatcherNew(a, &keywords);
+    String line = S("ok ok warning error7 then error42, error100");
+    String clean = S("no problems here, errors aside");
+    matches = StrMatcherFindAll(&large, &line);
+    if (matches.length != 5 || matches.data[0].pattern != 7 || matches.data[0].offset != 14 || matches.data[2].pattern != 42 ||
+        matches.data[4].pattern != 10 || matches.data[4].offset != 35 || !StrMatcherContains(&large, &line) ||
+        StrMatcherContains(&large, &clean)) {
+        LogError("StrMatcher large set fail");
+        exit(1);
+    }
+    VecFree(matches);
+    VecFree(keywords);
+
+    // NOTE: Nested patterns, every position of the run matches all of them
+    StringVector nested = {0};
+    for (i32 i = 1; i <= 40; i++) {
+        VecPush(nested, F(a, "%0*d", i, 0));
+    }
+    String zeros = F(a, "%02000d", 0);
+    StrMatcher nestedMatcher = StrMatcherNew(a, &nested);
+    matches = StrMatcherFindAll(&nestedMatcher, &zeros);
+    size_t expected = 0;
+    for (size_t length = 1; length <= 40; length++) {
+        expected += 2000 - length + 1;
+    }
+    for (size_t i = 1; i < matches.length; i++) {
+        StrMatch* previous = &matches.data[i - 1];
+        StrMatch* match = &matches.data[i];
+        if (previous->offset > match->offset || (previous->offset == match->offset && previous->pattern >= match->pattern)) {
+            LogError("StrMatcher nested order fail at %zu", i);
+            exit(1);
+        }
+    }
+    if (matches.length != expected) {
+        LogError("StrMatcher nested count fail");
+        exit(1);
+    }
+    VecFree(matches);
+    VecFree(nested);
+    ArenaFree(a);
+}
+
+static void TestStrCase() {
+    Arena* a = ArenaCreate(4096);
+    String header = StrNew(a, "Content-Type: Application/JSON; charset=UTF-8 \xC3\x89t\xC3\xA9");
+    StrToLower(&header);
+    if (!StrEqual(&header, &S("content-type: application/json; charset=utf-8 \xC3\x89t\xC3\xA9"))) {
+        LogError("StrToLower fail");
+        exit(1);
+    }
+    StrToUpper(&header);
+    if (!StrEqual(&header, &S("CONTENT-TYPE: APPLICATION/JSON; CHARSET=UTF-8 \xC3\x89T\xC3\xA9"))) {
+        LogError("StrToUpper fail");
+        exit(1);
+    }
+    String mixed = S("Content-Type: application/json; CHARSET=utf-8 \xC3\x89t\xC3\xA9");
+    if (!StrEqualNoCase(&header, &mixed) || StrEqualNoCase(&header, &S("CONTENT-TYPE")) || StrCompareNoCase(&header, &mixed) != 0 ||
+        StrCompareNoCase(&S("apple"), &S("BANANA")) >= 0 || StrCompareNoCase(&S("Zeta"), &S("alpha")) <= 0 ||
+        StrCompareNoCase(&S("ABC"), &S("abcd")) >= 0) {
+        LogError("StrEqualNoCase fail");
+        exit(1);
+    }
+
+    String longer = F(a, "%0400d", 0);
+    memset(longer.data, 'X', longer.length);
+    String lowered = StrNewSize(a, longer.data, longer.length);
+    StrToLower(&lowered);
+    if (StrHashNoCase(&header) != StrHashNoCase(&mixed) || StrHashNoCase(&longer) != StrHash(&lowered)) {
+        LogError("StrHashNoCase fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestStrTrim() {
+    String field = S(" \t 42,5 \r\n");
+    String trimmed = StrTrimView(&field);
+    String left = StrTrimLeft(&field);
+    String right = StrTrimRight(&field);
+    if (!StrEqual(&trimmed, &S("42,5")) || trimmed.data != field.data + 3 || !StrEqual(&left, &S("42,5 \r\n")) ||
+        !StrEqual(&right, &S(" \t 42,5"))) {
+        LogError("StrTrimView fail");
+        exit(1);
+    }
+    String blank = S(" \v\f ");
+    String empty = StrTrimView(&blank);
+    if (empty.length != 0 || StrTrimLeft(&blank).length != 0 || StrTrimRight(&blank).length != 0) {
+        LogError("StrTrimView blank fail");
+        exit(1);
+    }
+
+    Arena* a = ArenaCreate(4096);
+    String owned = StrNew(a, "  padded value\t");
+    StrTrim(&owned);
+    if (!StrEqual(&owned, &S("padded value")) || owned.data[owned.length] != '\0') {
+        LogError("StrTrim fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestStrFromCStr() {
+    Arena* a = ArenaCreate(4096);
+    char* big = Malloc(20001);
+    memset(big, 'x', 20000);
+    big[20000] = '\0';
+    String copy = StrNew(a, big);
+    String view = StrFromCStr(big + 3);
+    String capped = StrNewMax(a, big, 12);
+    char raw[5] = {'a', 'b', 'c', 'd', 'e'}; // NOTE: No terminator, the cap is what stops the scan
+    String bounded = StrFromCStrMax(raw, sizeof(raw));
+    if (copy.length != 20000 || view.length != 19997 || capped.length != 12 || capped.data[12] != '\0' || bounded.length != 5 ||
+        StrFromCStr(NULL).length != 0 || StrFromCStrMax("ab\0cd", 5).length != 2) {
+        LogError("StrFromCStr fail");
+        exit(1);
+    }
+    Free(big);
+    ArenaFree(a);
+}
+
+static void TestUtf8() {
+    Arena* a = ArenaCreate(4096);
+    String text = S("na\xC3\xAFve caf\xC3\xA9 \xE2\x82\xAC 5 \xF0\x9F\x98\x80 and some more ascii to fill a block");
+    if (!StrIsValidUtf8(&text) || StrUtf8Length(&text) != text.length - 7) {
+        LogError("StrIsValidUtf8 fail");
+        exit(1);
+    }
+    String invalid[] = {S("\xC0\xAF"), S("\xED\xA0\x80"), S("\xF4\x90\x80\x80"), S("caf\xC3"), S("\x80"), S("\xE2\x82 a")};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        if (StrIsValidUtf8(&invalid[i])) {
+            LogError("StrIsValidUtf8 accepted invalid input %zu", i);
+            exit(1);
+        }
+    }
+
+    u32 expected[] = {'x', 0xE9, 0xFFFD, 0x1F600};
+    String mixed = S("x\xC3\xA9\xFF\xF0\x9F\x98\x80");
+    size_t count = 0;
+    StrUtf8ForEach(&mixed, it) {
+        if (count >= 4 || it.codepoint != expected[count]) {
+            LogError("StrUtf8Next fail");
+            exit(1);
+        }
+        count++;
+    }
+
+    StrUtf32 codepoints;
+    String back;
+    if (StrToUtf32(a, &text, &codepoints) != SUCCESS || codepoints.length != StrUtf8Length(&text) || codepoints.data[2] != 0xEF ||
+        StrFromUtf32(a, &codepoints, &back) != SUCCESS || !StrEqual(&back, &text) || count != 4 ||
+        StrToUtf32(a, &mixed, &codepoints) != STR_UTF8_INVALID) {
+        LogError("StrToUtf32 fail");
+        exit(1);
+    }
+    u32 surrogate[] = {'a', 0xD800};
+    if (StrFromUtf32(a, &(StrUtf32){.data = surrogate, .length = 2}, &back) != STR_UTF8_INVALID) {
+        LogError("StrFromUtf32 fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestStringBuilder() {
+    Arena* a = ArenaCreate(4096);
+    StringBuilder builder = StrBuilderNew(a, 0);
+    char *start = NULL;
+    for (i32 i = 0; i < 100; i++) {
+        StrBuilderAppend(&builder, &S("row "));
+        StrBuilderAppendI64(&builder, -i);
+        StrBuilderAppendChar(&builder, '\n');
+        if (i == 0) start = builder.data;
+    }
+    StrBuilderAppendF(&builder, "%s=%.2f", "total", 1.5);
+    size_t offset = a->offset;
+    String report = StrBuilderFinish(&builder);
+    if (report.data != start || a->offset >= offset || !StrEqual(&(String){6, report.data + 6}, &S("row -1")) || report.data[report.length] != '\0') {
+        LogError("StringBuilder arena fail");
+        exit(1);
+    }
+
+    StringBuilder heap = StrBuilderNew(NULL, 4);
+    StrBuilderAppendF(&heap, "%0100d", 7);
+    StrBuilderAppendF64(&heap, 0.25);
+    String text = StrBuilderFinish(&heap);
+    if (text.length != 104 || text.data[99] != '7' || !StrEqual(&(String){4, text.data + 100}, &S("0.25"))) {
+        LogError("StringBuilder heap fail");
+        exit(1);
+    }
+    StrBuilderFree(&heap);
+
+    String name = S("disk");
+    String line = Fmt(a, "[%-6S] %05d %x %.*s %.3f%%", &name, -42, 255u, 3, "usage", 99.9996);
+    String big = F(a, "%04000d", 1);
+    if (!StrEqual(&line, &S("[disk  ] -0042 ff usa 100.000%")) || big.length != 4000 || big.data[3999] != '1') {
+        LogError("Fmt fail: %s", line.data);
+        exit(1);
+    }
+    String flags = Fmt(a, "%+d|% d|%#x|%.3d|%hhd|%020.12f|%s|%g|%q", 5, 5, 255, 7, 300, 1.5, (char*)NULL, 0.5);
+    if (!StrEqual(&flags, &S("+5| 5|0xff|007|44|0000001.500000000000|(null)|0.5|%q"))) {
+        LogError("Fmt flags fail: %s", flags.data);
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestStrParse() {
+    i64 integer;
+    u64 unsigned64;
+    f64 number;
+    if (StrToI64(&S("-9223372036854775808"), &integer) != SUCCESS || integer != I64_MIN || StrToI64(&S("9223372036854775808"), &integer) != STR_PARSE_OVERFLOW) {
+        LogError("StrToI64 fail");
+        exit(1);
+    }
+    if (StrToU64(&S("18446744073709551615"), &unsigned64) != SUCCESS || unsigned64 != U64_MAX || StrToU64(&S("12a"), &unsigned64) != STR_PARSE_INVALID) {
+        LogError("StrToU64 fail");
+        exit(1);
+    }
+    if (StrToU64Hex(&S("0xDeadBeef"), &unsigned64) != SUCCESS || unsigned64 != 0xDEADBEEF || StrToI64Hex(&S("-ff"), &integer) != SUCCESS || integer != -255) {
+        LogError("StrToHex fail");
+        exit(1);
+    }
+    String column = S("3.14159,-2.5e-3,1e400,0.1,12345678901234567890123");
+    f64 expected[] = {3.14159, -2.5e-3, INFINITY, 0.1, 12345678901234567890123.0};
+    size_t count = 0;
+    StrSplitForEach(&column, &S(","), it) {
+        errno_t error = StrToF64(&it.value, &number);
+        if ((error != SUCCESS && count != 2) || number != expected[count++]) {
+            LogError("StrToF64 fail: %.*s", (int)it.value.length, it.value.data);
+            exit(1);
+        }
+    }
+    // NOTE: Ties past the 19th digit, settled by the digits Eisel-Lemire can't see
+    String ties[] = {S("9007199254740993.000000000000000000"), S("9007199254740993.000000000000000001"), S("1.00000000000000011102230246251565404236316680908203125"), S("1.000000000000000111022302462515654042363166809082031250001")};
+    f64 rounded[] = {9007199254740992.0, 9007199254740994.0, 1.0, 1.0000000000000002};
+    for (size_t i = 0; i < 4; i++) {
+        if (StrToF64(&ties[i], &number) != SUCCESS || number != rounded[i]) {
+            LogError("StrToF64 tie fail: %.*s", (int)ties[i].length, ties[i].data);
+            exit(1);
+        }
+    }
+
+    Arena* a = ArenaCreate(1024);
+    f64 values[] = {0.1, -1234.5678, 1e21, 5e-324, 0.000001, 1.0 / 3.0};
+    char *printed[] = {"0.1", "-1234.5678", "1e+21", "5e-324", "0.000001", "0.3333333333333333"};
+    for (size_t i = 0; i < 6; i++) {
+        String text = StrFromF64(a, values[i]);
+        String expectedText = s(printed[i]);
+        if (!StrEqual(&text, &expectedText) || StrToF64(&text, &number) != SUCCESS || number != values[i]) {
+            LogError("StrFromF64 fail: %s", text.data);
+            exit(1);
+        }
+    }
+    String minimum = StrFromI64(a, I64_MIN);
+    String maximum = StrFromU64(a, U64_MAX);
+    if (!StrEqual(&minimum, &S("-9223372036854775808")) || !StrEqual(&maximum, &S("18446744073709551615"))) {
+        LogError("StrFromI64 fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static void TestHashing() {
+    u8 data[300];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 31 + 7);
+    }
+    for (size_t length = 0; length <= sizeof(data); length++) {
+        HashState state;
+        HashInit(&state, 42);
+        for (size_t offset = 0; offset < length; offset += 7) {
+            HashUpdate(&state, data + offset, Min(7, length - offset));
+        }
+        Hash128 full = HashBytes128(data, length, 42);
+        if (HashFinal(&state) != HashBytes(data, length, 42) || HashFinal128(&state).high != full.high) {
+            LogError("Hash streaming mismatch at length %zu", length);
+            exit(1);
+        }
+    }
+    if (StrHash(&S("hello")) == StrHash(&S("hellp")) || HashBytes(data, 16, 0) == HashBytes(data, 16, 1)) {
+        LogError("Hash collision fail");
+        exit(1);
+    }
+}
+
+MAP_TYPE(StrIntMap, String, i32);
+MAP_TYPE(IdMap, u64, u64);
+
+static void TestMaps() {
+    StrIntMap names = {0};
+    MapPut(names, S("one"), 1);
+    MapPut(names, S("two"), 2);
+    MapPut(names, S("one"), 10);
+    char buffer[] = "two";
+    i32 *two = MapGet(names, s(buffer));
+    if (MapLength(names) != 2 || *MapGet(names, S("one")) != 10 || two == NULL || *two != 2 || MapHas(names, S("three"))) {
+        LogError("Map string keys fail");
+        exit(1);
+    }
+    MapFree(names);
+
+    Arena* a = ArenaCreate(1024);
+    IdMap ids;
+    MapInit(ids, a);
+    for (u64 i = 0; i < 10000; i++) {
+        MapPut(ids, i, i * 2);
+    }
+    for (u64 i = 0; i < 10000; i += 2) {
+        MapRemove(ids, i);
+    }
+    size_t count = 0;
+    MapForEach(ids, it) {
+        if (it->key % 2 == 0 || it->value != it->key * 2) {
+            LogError("Map iteration fail");
+            exit(1);
+        }
+        count++;
+    }
+    if (count != 5000 || MapLength(ids) != 5000 || MapGet(ids, 4) != NULL || *MapGet(ids, 5) != 10) {
+        LogError("Map remove fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+CONCURRENT_MAP_TYPE(SharedCounters, String, i64);
+
+static void AddToCounter(void *value, bool exists, void *userData) {
+    i64 *counter = value;
+    *counter = (exists ? *counter : 100) + *(i64 *)userData;
+}
+
+#if defined(PLATFORM_LINUX)
+#    define CONCURRENT_TEST_THREADS 8
+#    define CONCURRENT_TEST_ROUNDS 20000
+
+static SharedCounters sharedCounters;
+static char* counterKeys[16] = {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9", "k10", "k11", "k12", "k13", "k14", "k15"};
+
+// NOTE: Every thread hits the same 16 keys so the shards are actually contended, the map keeps the key
+// views so they point at literals
+static void* CounterWorker(void* arg) {
+    i64 id = (i64)(intptr_t)arg;
+    i64 one = 1;
+    for (i32 i = 0; i < CONCURRENT_TEST_ROUNDS; i++) {
+        ConcurrentMapCompute(sharedCounters, s(counterKeys[i % 16]), AddToCounter, &one);
+        ConcurrentMapPutIfAbsent(sharedCounters, S("owner"), id);
+        i64 value;
+        if (!ConcurrentMapGet(sharedCounters, s(counterKeys[i % 16]), &value) || value < 101) {
+            LogError("ConcurrentMap threaded get fail");
+            exit(1);
+        }
+    }
+    return NULL;
+}
+
+static void TestConcurrentMapsThreaded() {
+    ConcurrentMapInit(sharedCounters);
+    pthread_t threads[CONCURRENT_TEST_THREADS];
+    for (i64 t = 0; t < CONCURRENT_TEST_THREADS; t++) {
+        pthread_create(&threads[t], NULL, CounterWorker, (void*)(intptr_t)t);
+    }
+    for (i32 t = 0; t < CONCURRENT_TEST_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // NOTE: `AddToCounter` starts a missing key at 100, so every increment must show up exactly once
+    i64 total = 0;
+    for (i32 k = 0; k < 16; k++) {
+        i64 value = 0;
+        ConcurrentMapGet(sharedCounters, s(counterKeys[k]), &value);
+        total += value - 100;
+    }
+    i64 owner = -1;
+    if (total != CONCURRENT_TEST_THREADS * CONCURRENT_TEST_ROUNDS || !ConcurrentMapGet(sharedCounters, S("owner"), &owner) || owner < 0 ||
+        owner >= CONCURRENT_TEST_THREADS || ConcurrentMapLength(sharedCounters) != 17) {
+        LogError("ConcurrentMap threaded totals fail: %lld", (long long)total);
+        exit(1);
+    }
+    ConcurrentMapFree(sharedCounters);
+}
+#endif
+
+static void TestConcurrentMaps() {
+    SharedCounters counters;
+    ConcurrentMapInit(counters);
+    i64 value = 0;
+    bool firstInsert = ConcurrentMapPutIfAbsent(counters, S("hits"), 1);
+    bool secondInsert = ConcurrentMapPutIfAbsent(counters, S("hits"), 2);
+    if (!firstInsert || secondInsert || !ConcurrentMapGet(counters, S("hits"), &value) || value != 1) {
+        LogError("ConcurrentMap insert if absent fail");
+        exit(1);
+    }
+    i64 amount = 5;
+    ConcurrentMapCompute(counters, S("hits"), AddToCounter, &amount);
+    ConcurrentMapCompute(counters, S("misses"), AddToCounter, &amount);
+    ConcurrentMapGet(counters, S("hits"), &value);
+    i64 misses = 0;
+    ConcurrentMapGet(counters, S("misses"), &misses);
+    if (value != 6 || misses != 105 || ConcurrentMapLength(counters) != 2) {
+        LogError("ConcurrentMap compute fail");
+        exit(1);
+    }
+    if (!ConcurrentMapRemove(counters, S("hits")) || ConcurrentMapGet(counters, S("hits"), &value)) {
+        LogError("ConcurrentMap remove fail");
+        exit(1);
+    }
+    ConcurrentMapFree(counters);
+}
+
+static void TestIntMaps() {
+    IntMap map = {0};
+    IntSet set = {0};
+    for (u64 i = 0; i < 20000; i++) {
+        IntMapPut(&map, i * 7, i);
+        IntSetAdd(&set, i * 7);
+    }
+    for (u64 i = 0; i < 20000; i += 3) {
+        IntMapRemove(&map, i * 7);
+        IntSetRemove(&set, i * 7);
+    }
+    u64 keys[64];
+    u64 *values[64];
+    bool found[64];
+    for (u64 i = 0; i < 64; i++) {
+        keys[i] = i * 7;
+    }
+    IntMapGetMany(&map, keys, 64, values);
+    IntSetHasMany(&set, keys, 64, found);
+    for (u64 i = 0; i < 64; i++) {
+        bool removed = i % 3 == 0;
+        if ((values[i] == NULL) != removed || (values[i] && *values[i] != i) || found[i] == removed) {
+            LogError("IntMap lookup fail at %llu", (unsigned long long)i);
+            exit(1);
+        }
+    }
+    if (map.length != 13333 || set.length != 13333 || IntMapGet(&map, 8) != NULL || IntSetAdd(&set, 7)) {
+        LogError("IntMap length fail");
+        exit(1);
+    }
+    IntMapFree(&map);
+    IntSetFree(&set);
+}
+
+static void TestInterning() {
+    InternTable *table = InternTableCreate();
+    char path[] = "src/main.c";
+    u32 first = StrIntern(table, &S("src/main.c"));
+    u32 second = StrIntern(table, &S("src/util.c"));
+    String pathStr = s(path);
+    u32 again = StrIntern(table, &pathStr);
+    String stored = StrInternGet(table, first);
+    if (first != again || first == second || !StrEqual(&stored, &S("src/main.c")) || stored.data == path) {
+        LogError("Interning fail");
+        exit(1);
+    }
+    for (u32 i = 0; i < 5000; i++) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "key%u", i);
+        String key = s(buffer);
+        StrIntern(table, &key);
+    }
+    u32 found;
+    String last = StrInternGet(table, 5001);
+    if (!StrInternFind(table, &S("key4999"), &found) || found != 5001 || !StrEqual(&last, &S("key4999"))) {
+        LogError("Interning pages fail");
+        exit(1);
+    }
+    InternTableFree(table);
+}
+
+BTREE_TYPE(TimeIndex, i64, i32);
+
+static void TestBTrees() {
+    i64 keys[1000];
+    i32 values[1000];
+    for (i32 i = 0; i < 1000; i++) {
+        keys[i] = i * 10;
+        values[i] = i;
+    }
+    Arena* a = ArenaCreate(4096);
+    TimeIndex index;
+    BTreeInit(index, a);
+    BTreeBuild(index, keys, values, 1000);
+    for (i32 i = 0; i < 1000; i += 2) {
+        BTreeRemove(index, (i64)i * 10);
+    }
+    BTreePut(index, 15, -1);
+    i64 expected[] = {15, 30, 50, 70};
+    size_t count = 0;
+    BTreeForEachFrom(index, 11, it) {
+        if (count == 4) break;
+        if (BTreeKey(index, it) != expected[count++]) {
+            LogError("BTree range fail");
+            exit(1);
+        }
+    }
+    if (BTreeLength(index) != 501 || BTreeGet(index, 20) != NULL || *BTreeGet(index, 9990) != 999) {
+        LogError("BTree lookup fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+static bool countRoute(String key, void *value, void *userData) {
+    (void)key;
+    (void)value;
+    (*(u32 *)userData)++;
+    return true;
+}
+
+static void TestRadixTree() {
+    Arena* a = ArenaCreate(4096);
+    RadixTree routes;
+    RadixTreeInit(&routes, a);
+    String paths[] = {S("/"), S("/api"), S("/api/users"), S("/api/users/admin"), S("/static"), S("/api/posts")};
+    for (size_t i = 0; i < 6; i++) {
+        RadixTreeInsert(&routes, &paths[i], (void *)(i + 1));
+    }
+    for (u32 i = 0; i < 300; i++) {
+        String key = F(a, "/files/%u", i);
+        RadixTreeInsert(&routes, &key, (void *)(size_t)i);
+    }
+    RadixTreeRemove(&routes, &S("/api/users"));
+
+    size_t length;
+    String request = S("/api/users/42");
+    if (RadixTreeLongestPrefix(&routes, &request, &length) != (void *)2 || length != 4) {
+        LogError("RadixTree longest prefix fail");
+        exit(1);
+    }
+    u32 count = 0;
+    RadixTreeForEachPrefix(&routes, &S("/api"), countRoute, &count);
+    if (count != 3 || routes.length != 305 || RadixTreeGet(&routes, &S("/files/299")) != (void *)299) {
+        LogError("RadixTree lookup fail");
+        exit(1);
+    }
+    ArenaFree(a);
+}
+
+// NOTE: Fresh directory per run so the test works from any working directory, removed by the caller
+static String TestTempDir(Arena* a) {
+#if defined(PLATFORM_WIN)
+    char base[MAX_PATH];
+    GetTempPathA(MAX_PATH, base);
+    String dir = F(a, "%sbase_test_%d", base, getpid());
+    if (mkdir(dir.data, 0700) != 0) {
+#else
+    char* base = getenv("TMPDIR");
+    String dir = F(a, "%s/base_test_XXXXXX", base && base[0] ? base : "/tmp");
+    if (mkdtemp(dir.data) == NULL) {
+#endif
+        LogError("Temp dir create fail: %s", dir.data);
+        exit(1);
+    }
+    return dir;
+}
+
+static void TestFileCache() {
+    Arena* a = ArenaCreate(1024);
+    String dir = TestTempDir(a);
+    String first = F(a, "%s/cache_1.txt", dir.data);
+    String second = F(a, "%s/cache_2.txt", dir.data);
+    String missing = F(a, "%s/missing.txt", dir.data);
+    String inside = F(a, "%s/cache_1.txt/inside.txt", dir.data);
+    FileWrite(&first, &S("first"));
+    FileWrite(&second, &S("second!"));
+
+    FileCache *cache = FileCacheCreate(10, 0);
+    String contents;
+    if (FileCacheRead(cache, &first, &contents) != SUCCESS || !StrEqual(&contents, &S("first"))) {
+        LogError("FileCache read fail");
+        exit(1);
+    }
+    String again;
+    FileCacheRead(cache, &first, &again);
+    if (again.data != contents.data) {
+        LogError("FileCache hit fail");
+        exit(1);
+    }
+    FileCacheRead(cache, &second, &contents);
+    if (cache->bytes != 7 || MapLength(cache->entries) != 1) {
+        LogError("FileCache eviction fail");
+        exit(1);
+    }
+    FileWrite(&second, &S("changed"));
+    FileWrite(&second, &S("changed!!"));
+    FileCacheRead(cache, &second, &contents);
+    if (!StrEqual(&contents, &S("changed!!"))) {
+        LogError("FileCache revalidation fail");
+        exit(1);
+    }
+    // NOTE: Only a missing file is FILE_NOT_EXIST, a path through a regular file fails with ENOTDIR
+    if (FileCacheRead(cache, &missing, &contents) != FILE_NOT_EXIST || FileCacheRead(cache, &inside, &contents) != FILE_OPEN_FAILED) {
+        LogError("FileCache error mapping fail");
+        exit(1);
+    }
+    FileCacheFree(cache);
+    FileDelete(&first);
+    FileDelete(&second);
+    rmdir(dir.data);
+    ArenaFree(a);
+}
+
+static void TestBloomFilters() {
+    for (i32 blocked = 0; blocked <= 1; blocked++) {
+        BloomFilter filter = BloomFilterCreate(1000, 0.01, blocked);
+        for (u32 i = 0; i < 1000; i++) {
+            BloomFilterAdd(&filter, &i, sizeof(i));
+        }
+        u32 falsePositives = 0;
+        for (u32 i = 0; i < 10000; i++) {
+            u32 key = i + 1000;
+            falsePositives += BloomFilterHas(&filter, &key, sizeof(key));
+        }
+        BloomFilterAddStr(&filter, &S("key"));
+
+        String path = S("base_test_bloom.bin");
+        BloomFilter loaded;
+        u32 present = 999;
+        if (BloomFilterSave(&filter, &path) != SUCCESS || BloomFilterLoad(&path, &loaded) != SUCCESS) {
+            LogError("BloomFilter save fail");
+            exit(1);
+        }
+        if (falsePositives > 300 || !BloomFilterHasStr(&loaded, &S("key")) || !BloomFilterHas(&loaded, &present, sizeof(present))) {
+            LogError("BloomFilter lookup fail, %u false positives", falsePositives);
+            exit(1);
+        }
+        FileDelete(&path);
+        BloomFilterFree(&filter);
+        BloomFilterFree(&loaded);
+    }
+
+    // NOTE: Same bits, but a hash count BloomFilterCreate never produces
+    BloomFilter filter = BloomFilterCreate(100, 0.01, false);
+    String path = S("base_test_bloom.bin");
+    BloomFilter loaded;
+    u32 hashCounts[] = {0, 33};
+    for (size_t i = 0; i < 2; i++) {
+        filter.hashCount = hashCounts[i];
+        if (BloomFilterSave(&filter, &path) != SUCCESS || BloomFilterLoad(&path, &loaded) != BLOOM_FILTER_INVALID_FORMAT) {
+            LogError("BloomFilter hash count %u not rejected", hashCounts[i]);
+            exit(1);
+        }
+    }
+    FileDelete(&path);
+    BloomFilterFree(&filter);
+}
+
 int main() {
     TestVectors();
+    TestSlotMaps();
     TestArenas();
+    TestStrSplit();
+    TestStrFind();
+    TestStrMatcher();
+    TestStrCase();
+    TestStrTrim();
+    TestStrFromCStr();
+    TestUtf8();
+    TestStringBuilder();
+    TestStrParse();
+    TestHashing();
+    TestMaps();
+    TestConcurrentMaps();
+#if defined(PLATFORM_LINUX)
+    TestConcurrentMapsThreaded();
+#endif
+    TestIntMaps();
+    TestInterning();
+    TestBTrees();
+    TestRadixTree();
+    TestFileCache();
+    TestBloomFilters();
     LogInfo("Tests passed!");
 }
\ No newline at end of file